@@ -0,0 +1,13 @@
+extern unsigned nondet_unsigned();
+int main()
+{
+  unsigned n = nondet_unsigned();
+  __CPROVER_assume(n<10);
+  unsigned i = 0, x = 0;
+  while(i<n) {
+    i=i+1;
+    x=x+2;
+  }
+  unsigned y = x;
+  assert(y!=6);
+}
@@ -0,0 +1,13 @@
+extern unsigned nondet_unsigned();
+int main()
+{
+  unsigned n = nondet_unsigned();
+  unsigned i, x = 0;
+  for(i=0; i<10; i++) {
+    if(i==n)
+      break;
+    x=x+2;
+  }
+  unsigned y = x;
+  assert(y!=6);
+}
@@ -0,0 +1,8 @@
+int main()
+{
+  int x;
+  while(x<4) {
+    x=x+1;
+  }
+  assert(x<4);
+}
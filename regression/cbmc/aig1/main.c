@@ -0,0 +1,10 @@
+int main()
+{
+  unsigned char a, b;
+  unsigned char c = a * b;
+
+  __CPROVER_assert((a & b) == (b & a), "and commutes");
+  __CPROVER_assert((a ^ a) == 0, "xor with itself");
+  __CPROVER_assert(c != 42, "product is not 42");
+  return 0;
+}
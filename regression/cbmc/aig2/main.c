@@ -0,0 +1,14 @@
+int main()
+{
+  unsigned short x, y;
+  unsigned q, r;
+
+  __CPROVER_assume(y != 0);
+  q = x / y;
+  r = x % y;
+
+  __CPROVER_assert(q * y + r == x, "division");
+  __CPROVER_assert(x * y == y * x, "product commutes");
+  __CPROVER_assert((x | y) >= (x & y), "or and and");
+  return 0;
+}
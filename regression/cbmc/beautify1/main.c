@@ -0,0 +1,13 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned x=nondet_unsigned();
+  unsigned y=nondet_unsigned();
+  unsigned z=nondet_unsigned();
+
+  __CPROVER_assume(x >= 8 || (y >= 8 && z >= 8));
+  __CPROVER_assert(x + y + z < 8, "small sum");
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  unsigned x;
+  int y;
+  __CPROVER_assume(y >= 0 && y < 100);
+
+  __CPROVER_assert(x * 255 == (x << 8) - x, "255");
+  __CPROVER_assert(
+    x * 0x7f7f7f7f == x * 0x7f000000 + x * 0x7f0000 + x * 0x7f00 + x * 0x7f,
+    "0x7f7f7f7f");
+  __CPROVER_assert(y * -7 == -(y * 7), "negative constant");
+  __CPROVER_assert(y * 10 != 50, "not five");
+  return 0;
+}
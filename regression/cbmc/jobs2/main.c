@@ -0,0 +1,15 @@
+int a[4];
+
+int main()
+{
+  unsigned i;
+  __CPROVER_assume(i < 4);
+
+  for(int j = 0; j < 4; j++)
+    a[j] = j * j;
+
+  __CPROVER_assert(a[i] <= 9, "upper bound");
+  __CPROVER_assert(a[i] >= 0, "lower bound");
+  __CPROVER_assert(a[i] != 2, "not two");
+  return 0;
+}
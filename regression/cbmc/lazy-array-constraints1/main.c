@@ -0,0 +1,22 @@
+int a[100000];
+
+int main()
+{
+  unsigned i, j, k;
+  int v;
+
+  __CPROVER_assume(i < 100000 && j < 100000 && k < 100000);
+
+  a[i] = v;
+  __CPROVER_assert(a[i] == v, "read over write");
+
+  if(i == j)
+    __CPROVER_assert(a[i] == a[j], "same index");
+
+  int old = a[k];
+  a[j] = v + 1;
+  if(k != j)
+    __CPROVER_assert(a[k] == old, "other index unchanged");
+
+  return 0;
+}
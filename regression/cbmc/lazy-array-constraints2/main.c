@@ -0,0 +1,14 @@
+int main()
+{
+  unsigned n, i, j;
+  __CPROVER_assume(n > 2 && n < 1000000);
+  __CPROVER_assume(i < n && j < n);
+
+  int a[n];
+  a[i] = 1;
+  a[j] = 2;
+
+  __CPROVER_assert(a[i] == 1, "overwritten");
+  __CPROVER_assert(a[j] == 2, "last write");
+  return 0;
+}
@@ -0,0 +1,11 @@
+int main()
+{
+  unsigned char a, b;
+  unsigned x;
+
+  __CPROVER_assume(a > 1 && b > 1 && a <= b);
+
+  __CPROVER_assert(x * 3 == x + x + x, "times three");
+  __CPROVER_assert(a * b != 143, "143 is prime");
+  return 0;
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  int x, y, z;
+  unsigned long long u, v;
+
+  __CPROVER_assert((-x) * y == -(x * y), "negation");
+  __CPROVER_assert(x * (y + z) == x * y + x * z, "distributivity");
+  __CPROVER_assert(u * v == v * u, "64-bit product commutes");
+  return 0;
+}
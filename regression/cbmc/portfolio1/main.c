@@ -0,0 +1,9 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x > 1 && y > 1 && x <= y && y < 1000);
+
+  __CPROVER_assert(x * y != 899, "899 is prime");
+  __CPROVER_assert(x <= y, "ordered");
+  return 0;
+}
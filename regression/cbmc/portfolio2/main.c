@@ -0,0 +1,20 @@
+#define N 5
+
+int main()
+{
+  int a[N];
+
+  for(int i = 0; i < N; i++)
+    for(int j = 0; j + 1 < N - i; j++)
+      if(a[j] > a[j + 1])
+      {
+        int t = a[j];
+        a[j] = a[j + 1];
+        a[j + 1] = t;
+      }
+
+  for(int i = 0; i + 1 < N; i++)
+    __CPROVER_assert(a[i] <= a[i + 1], "sorted");
+
+  return 0;
+}
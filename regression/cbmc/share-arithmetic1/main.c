@@ -0,0 +1,14 @@
+int main()
+{
+  unsigned x, y, z;
+
+  __CPROVER_assert(x * y == y * x, "product commutes");
+  __CPROVER_assert(x * y * z == z * (y * x), "product associates");
+
+  if(y != 0)
+    __CPROVER_assert(x / y * y + x % y == x, "division");
+
+  __CPROVER_assert(x / 10 * 10 + x % 10 == x, "division by a constant");
+  __CPROVER_assert(x * y != 12, "not twelve");
+  return 0;
+}
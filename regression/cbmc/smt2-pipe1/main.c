@@ -0,0 +1,10 @@
+int main()
+{
+  int x, y;
+  __CPROVER_assume(x > 0 && x < 10);
+
+  __CPROVER_assert(x != 5, "x is not five");
+  __CPROVER_assert(x < 10, "upper bound");
+  __CPROVER_assert(y != x, "y differs");
+  return 0;
+}
@@ -0,0 +1,15 @@
+#include <stdlib.h>
+
+int main()
+{
+  unsigned n;
+  __CPROVER_assume(n > 0 && n < 5);
+
+  int *p = malloc(n * sizeof(int));
+  for(unsigned i = 0; i < n; i++)
+    p[i] = i;
+
+  __CPROVER_assert(p[0] == 0, "first element");
+  __CPROVER_assert(p[n - 1] == n - 1, "last element");
+  return 0;
+}
@@ -0,0 +1,15 @@
+int main()
+{
+  int x, y, z = 0;
+
+  if(x > 0)
+    z += 1;
+  if(y > 0)
+    z += 2;
+  if(x > 10)
+    z += 4;
+
+  __CPROVER_assert(z != 7, "all branches taken");
+  __CPROVER_assert(z <= 7, "upper bound");
+  return 0;
+}
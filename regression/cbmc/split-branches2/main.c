@@ -0,0 +1,14 @@
+int main()
+{
+  int x, y, z = 0;
+
+  if(x > 0)
+    z += 1;
+  if(y > 0)
+    z += 2;
+  if(x > 10)
+    z += 4;
+
+  __CPROVER_assert(z != 4, "x>10 implies x>0");
+  return 0;
+}
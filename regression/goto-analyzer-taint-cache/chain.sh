@@ -0,0 +1,35 @@
+#!/bin/bash
+
+# Runs goto-analyzer twice with the same taint summary cache, starting
+# with the cache.json of the test if there is one, and with no cache
+# otherwise. If the test has an edited.c, the second run analyses that
+# instead; both runs then use a copy named run.c, so that the source
+# locations of the functions that were not edited stay the same.
+
+goto_analyzer=$1
+
+name=${*:$#}
+args=${*:2:$#-2}
+
+if [ -e cache.json ]; then
+  cp cache.json summaries.json
+else
+  rm -f summaries.json
+fi
+
+first="${name}"
+second="${name}"
+
+if [ -e edited.c ]; then
+  cp "${name}" run.c
+  first=run.c
+  second=run.c
+fi
+
+$goto_analyzer ${args} --taint-summary-cache summaries.json "${first}" || exit $?
+
+if [ -e edited.c ]; then
+  cp edited.c run.c
+fi
+
+$goto_analyzer ${args} --taint-summary-cache summaries.json "${second}"
@@ -0,0 +1,17 @@
+void my_f(void *p) { }
+void my_h(void *p) { }
+
+void use(void *p)
+{
+  my_h(p); // T1 sink
+}
+
+int main()
+{
+  void *o;
+
+  my_f(o); // T1 source
+  use(o);
+
+  return 0;
+}
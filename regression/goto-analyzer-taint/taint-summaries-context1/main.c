@@ -0,0 +1,22 @@
+void my_f(void *p) { }
+void my_h(void *p) { }
+
+void *id(void *p)
+{
+  return p;
+}
+
+int main()
+{
+  void *a, *b;
+
+  my_f(a); // T1 source
+
+  void *x=id(a);
+  void *y=id(b);
+
+  my_h(x); // T1 sink
+  my_h(y); // no flow
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+void my_f(void *p) { }
+void my_h(void *p) { }
+
+void odd(void *p, int n);
+
+void even(void *p, int n)
+{
+  if(n>0)
+    odd(p, n-1);
+}
+
+void odd(void *p, int n)
+{
+  if(n>1)
+    even(p, n-1);
+  else
+    my_h(p); // T1 sink
+}
+
+int main()
+{
+  void *o;
+
+  my_f(o); // T1 source
+  even(o, 4);
+
+  return 0;
+}
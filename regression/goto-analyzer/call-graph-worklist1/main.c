@@ -0,0 +1,21 @@
+int g(int x)
+{
+  return x+1;
+}
+
+int f(int x)
+{
+  return g(x)+1;
+}
+
+int main()
+{
+  int i=f(1);
+  int j=f(10);
+
+  assert(i>=3);
+  assert(j<=12);
+  assert(i!=5);
+
+  return 0;
+}
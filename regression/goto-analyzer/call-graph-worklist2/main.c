@@ -0,0 +1,21 @@
+int add(int a, int b)
+{
+  return a+b;
+}
+
+int twice(int a)
+{
+  return add(a, a);
+}
+
+int main()
+{
+  int x=twice(2);
+  int y=twice(2);
+
+  assert(x==4);
+  assert(y==4);
+  assert(x+y==8);
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <assert.h>
+
+void unreachable(int x)
+{
+  assert(x!=0);
+}
+
+void f(int x)
+{
+  assert(x>0);
+}
+
+void (*fp)(int)=f;
+
+int main()
+{
+  int x=0;
+  fp(x);
+  assert(x==0);
+  return 0;
+}
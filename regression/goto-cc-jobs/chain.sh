@@ -0,0 +1,15 @@
+#!/usr/bin/env bash
+
+# Compiles the test with goto-cc, passing it the options of the test,
+# which include the other source files, and checks the result with cbmc
+
+goto_cc=$1
+cbmc=$2
+
+options=${*:3:$#-3}
+name=${*:$#}
+name=${name%.c}
+
+"${goto_cc}" ${options} "${name}.c" -o "${name}.gb" || exit $?
+
+"${cbmc}" "${name}.gb"
@@ -0,0 +1,6 @@
+static int step = 1;
+
+int inc(int x)
+{
+  return x + step;
+}
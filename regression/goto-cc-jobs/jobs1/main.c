@@ -0,0 +1,12 @@
+int inc(int x);
+int dec(int x);
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x > 0 && x < 100);
+
+  __CPROVER_assert(dec(inc(x)) == x, "inverse");
+  __CPROVER_assert(inc(x) < 100, "bounded");
+  return 0;
+}
@@ -0,0 +1,6 @@
+extern int value;
+
+int get(void)
+{
+  return value;
+}
@@ -0,0 +1,9 @@
+int get(void);
+void set(int value);
+
+int main()
+{
+  set(42);
+  __CPROVER_assert(get() == 42, "value kept");
+  return 0;
+}
@@ -0,0 +1,6 @@
+int value;
+
+void set(int v)
+{
+  value = v;
+}
@@ -0,0 +1,84 @@
+int main()
+{
+  int x, y;
+
+  __CPROVER_set_may(&x, "bit0");
+  __CPROVER_set_may(&x, "bit1");
+  __CPROVER_set_may(&x, "bit2");
+  __CPROVER_set_may(&x, "bit3");
+  __CPROVER_set_may(&x, "bit4");
+  __CPROVER_set_may(&x, "bit5");
+  __CPROVER_set_may(&x, "bit6");
+  __CPROVER_set_may(&x, "bit7");
+  __CPROVER_set_may(&x, "bit8");
+  __CPROVER_set_may(&x, "bit9");
+  __CPROVER_set_may(&x, "bit10");
+  __CPROVER_set_may(&x, "bit11");
+  __CPROVER_set_may(&x, "bit12");
+  __CPROVER_set_may(&x, "bit13");
+  __CPROVER_set_may(&x, "bit14");
+  __CPROVER_set_may(&x, "bit15");
+  __CPROVER_set_may(&x, "bit16");
+  __CPROVER_set_may(&x, "bit17");
+  __CPROVER_set_may(&x, "bit18");
+  __CPROVER_set_may(&x, "bit19");
+  __CPROVER_set_may(&x, "bit20");
+  __CPROVER_set_may(&x, "bit21");
+  __CPROVER_set_may(&x, "bit22");
+  __CPROVER_set_may(&x, "bit23");
+  __CPROVER_set_may(&x, "bit24");
+  __CPROVER_set_may(&x, "bit25");
+  __CPROVER_set_may(&x, "bit26");
+  __CPROVER_set_may(&x, "bit27");
+  __CPROVER_set_may(&x, "bit28");
+  __CPROVER_set_may(&x, "bit29");
+  __CPROVER_set_may(&x, "bit30");
+  __CPROVER_set_may(&x, "bit31");
+  __CPROVER_set_may(&x, "bit32");
+  __CPROVER_set_may(&x, "bit33");
+  __CPROVER_set_may(&x, "bit34");
+  __CPROVER_set_may(&x, "bit35");
+  __CPROVER_set_may(&x, "bit36");
+  __CPROVER_set_may(&x, "bit37");
+  __CPROVER_set_may(&x, "bit38");
+  __CPROVER_set_may(&x, "bit39");
+  __CPROVER_set_may(&x, "bit40");
+  __CPROVER_set_may(&x, "bit41");
+  __CPROVER_set_may(&x, "bit42");
+  __CPROVER_set_may(&x, "bit43");
+  __CPROVER_set_may(&x, "bit44");
+  __CPROVER_set_may(&x, "bit45");
+  __CPROVER_set_may(&x, "bit46");
+  __CPROVER_set_may(&x, "bit47");
+  __CPROVER_set_may(&x, "bit48");
+  __CPROVER_set_may(&x, "bit49");
+  __CPROVER_set_may(&x, "bit50");
+  __CPROVER_set_may(&x, "bit51");
+  __CPROVER_set_may(&x, "bit52");
+  __CPROVER_set_may(&x, "bit53");
+  __CPROVER_set_may(&x, "bit54");
+  __CPROVER_set_may(&x, "bit55");
+  __CPROVER_set_may(&x, "bit56");
+  __CPROVER_set_may(&x, "bit57");
+  __CPROVER_set_may(&x, "bit58");
+  __CPROVER_set_may(&x, "bit59");
+  __CPROVER_set_may(&x, "bit60");
+  __CPROVER_set_may(&x, "bit61");
+  __CPROVER_set_may(&x, "bit62");
+  __CPROVER_set_may(&x, "bit63");
+  __CPROVER_set_may(&x, "bit64");
+  __CPROVER_set_may(&x, "bit65");
+  __CPROVER_set_may(&x, "bit66");
+  __CPROVER_set_may(&x, "bit67");
+  __CPROVER_set_may(&x, "bit68");
+  __CPROVER_set_may(&x, "bit69");
+  __CPROVER_set_must(&y, "bit69");
+
+  __CPROVER_assert(__CPROVER_get_may(&x, "bit0"), "may bit0");
+  __CPROVER_assert(__CPROVER_get_may(&x, "bit69"), "may bit69");
+  __CPROVER_assert(!__CPROVER_get_may(&y, "bit68"), "not may bit68");
+  __CPROVER_assert(__CPROVER_get_must(&y, "bit69"), "must bit69");
+  __CPROVER_assert(__CPROVER_get_must(&x, "bit69"), "not must bit69");
+
+  return 0;
+}
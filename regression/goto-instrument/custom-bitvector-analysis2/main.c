@@ -0,0 +1,28 @@
+int nondet_int();
+
+int main()
+{
+  int x, y, z;
+
+  if(nondet_int())
+  {
+    __CPROVER_set_must(&x, "both");
+    __CPROVER_set_must(&y, "one");
+    __CPROVER_set_may(&z, "one");
+  }
+  else
+  {
+    __CPROVER_set_must(&x, "both");
+    __CPROVER_set_must(&z, "one");
+  }
+
+  __CPROVER_assert(__CPROVER_get_must(&x, "both"), "must on both paths");
+  __CPROVER_assert(__CPROVER_get_must(&y, "one"), "must on one path");
+  __CPROVER_assert(__CPROVER_get_may(&z, "one"), "may on one path");
+  __CPROVER_assert(__CPROVER_get_must(&z, "one"), "must and may");
+
+  __CPROVER_clear_must(&x, "both");
+  __CPROVER_assert(__CPROVER_get_must(&x, "both"), "must cleared");
+
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int g;
+
+void set(int *p, int v)
+{
+  *p=v;
+}
+
+int main()
+{
+  int local;
+  int *q;
+  q=&local;
+  set(q, 1);
+  set(&g, 2);
+  assert(local==1);
+  assert(g==2);
+  return 0;
+}
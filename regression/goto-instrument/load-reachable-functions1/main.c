@@ -0,0 +1,11 @@
+int unreachable(int x)
+{
+  return x+1;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assert(x==0, "");
+  return 0;
+}
@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int x;
+
+int main()
+{
+  _Bool c;
+  int *p = c ? &x : 0;
+  int y = *p;
+  assert(y == x);
+  return 0;
+}
@@ -0,0 +1,23 @@
+#include <assert.h>
+#include <string.h>
+
+void f(void)
+{
+  assert(0);
+}
+
+void g(void)
+{
+}
+
+void (*fp)(void) = f;
+void (*gp)(void) = g;
+void (*fq)(void);
+
+int main()
+{
+  // the analysis does not see through memcpy, which has no body yet
+  memcpy(&fq, &fp, sizeof(fp));
+  fq();
+  return 0;
+}
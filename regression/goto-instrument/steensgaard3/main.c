@@ -0,0 +1,23 @@
+#include <assert.h>
+
+int called;
+
+void f(void)
+{
+  called = 1;
+}
+
+void g(void)
+{
+  called = 2;
+}
+
+void (*gp)(void) = g;
+
+int main()
+{
+  void (*fp)(void) = f;
+  fp();
+  assert(called == 1);
+  return 0;
+}
@@ -0,0 +1,60 @@
+#!/bin/bash
+
+# Compares two builds of cbmc, e.g., with and without HASH_CODE defined in
+# src/util/irep.h, on the largest regression tests: reports the runtime of
+# symbolic execution, of the conversion of the SSA and of cbmc overall.
+
+set -e
+
+script_folder=$(cd "$(dirname "$0")" && pwd)
+regression_folder="$script_folder/../regression/cbmc"
+
+if [[ $# -ne 2 ]] || ! [[ -x "$1" ]] || ! [[ -x "$2" ]]
+then
+  echo "Usage: $0 <cbmc> <other cbmc>"
+  exit 1
+fi
+
+# the tests with the largest sources
+tests=$(cd "$regression_folder" && \
+  for desc in */test.desc
+  do
+    test=$(dirname "$desc")
+    file=$(sed -n 2p "$desc")
+    if [[ -f "$test/$file" ]]
+    then
+      echo "$(wc -c < "$test/$file") $test"
+    fi
+  done | sort -rn | head -n "${TESTS:-20}" | cut -d ' ' -f 2)
+
+printf "%-32s %-8s %10s %10s %10s\n" test build symex convert total
+
+for test in $tests
+do
+  desc="$regression_folder/$test/test.desc"
+
+  # the second line of test.desc is the source file, the third the options
+  file=$(sed -n 2p "$desc")
+  options=$(sed -n 3p "$desc")
+
+  build=0
+  for cbmc in "$1" "$2"
+  do
+    build=$((build+1))
+
+    start=$(date +%s.%N)
+    # shellcheck disable=SC2086
+    output=$(cd "$regression_folder/$test" && \
+      timeout 300 "$cbmc" "$file" $options --verbosity 9 2>&1 || true)
+    stop=$(date +%s.%N)
+
+    symex=$(echo "$output" | \
+      sed -n 's/^Runtime Symex: \(.*\)s$/\1/p' | tail -n 1)
+    convert=$(echo "$output" | \
+      sed -n 's/^Runtime Convert SSA: \(.*\)s$/\1/p' | tail -n 1)
+
+    printf "%-32s %-8s %10s %10s %10.2f\n" \
+      "$test" "$build" "${symex:--}" "${convert:--}" \
+      "$(awk "BEGIN { print $stop - $start }")"
+  done
+done
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# Compares the encodings of multiplication and division on the arithmetic
+# regression tests: reports the size of the CNF and the runtime of cbmc
+# for each test and encoding.
+
+set -e
+
+script_folder=$(cd "$(dirname "$0")" && pwd)
+regression_folder="$script_folder/../regression/cbmc"
+
+cbmc=${1:-"$script_folder/../src/cbmc/cbmc"}
+
+if ! [[ -x "$cbmc" ]]
+then
+  echo "Usage: $0 [path to cbmc]"
+  echo "cbmc could not be found at $cbmc"
+  exit 1
+fi
+
+tests="BV_Arithmetic1 BV_Arithmetic2 BV_Arithmetic3 BV_Arithmetic4
+  BV_Arithmetic5 BV_Arithmetic6 Division1 Division2 Mod1 Mod2
+  Overflow_Multiplication1"
+
+encodings=(
+  "--multiplier shift-add"
+  "--multiplier wallace"
+  "--multiplier dadda"
+  "--multiplier shift-add --csd-multiplication"
+  "--multiplier dadda --csd-multiplication --share-arithmetic"
+)
+
+printf "%-24s %-56s %10s %10s %8s\n" \
+  test encoding variables clauses seconds
+
+for test in $tests
+do
+  desc="$regression_folder/$test/test.desc"
+
+  # the second line of test.desc is the source file, the third the options
+  file=$(sed -n 2p "$desc")
+  options=$(sed -n 3p "$desc")
+
+  for encoding in "${encodings[@]}"
+  do
+    start=$(date +%s.%N)
+    # shellcheck disable=SC2086
+    output=$(cd "$regression_folder/$test" && \
+      "$cbmc" "$file" $options $encoding 2>&1 || true)
+    stop=$(date +%s.%N)
+
+    size=$(echo "$output" | \
+      sed -n 's/^\([0-9]*\) variables, \([0-9]*\) clauses$/\1 \2/p' | \
+      tail -n 1)
+
+    if [[ -z "$size" ]]
+    then
+      size="- -"
+    fi
+
+    # shellcheck disable=SC2086
+    printf "%-24s %-56s %10s %10s %8.2f\n" \
+      "$test" "$encoding" $size "$(awk "BEGIN { print $stop - $start }")"
+  done
+done
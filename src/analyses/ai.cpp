@@ -14,11 +14,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <cassert>
 #include <memory>
 #include <sstream>
+#include <unordered_set>
+#include <vector>
 
 #include <util/simplify_expr.h>
 #include <util/std_expr.h>
 #include <util/std_code.h>
 
+#include "call_graph.h"
 #include "is_threaded.h"
 
 jsont ai_domain_baset::output_json(
@@ -538,6 +541,249 @@ void ai_baset::sequential_fixedpoint(
     fixedpoint(f_it->second.body, goto_functions, ns);
 }
 
+void ai_baset::call_graph_worklistt::put(
+  locationt l,
+  const goto_programt &goto_program)
+{
+  const auto r_it=rank.find(l->function);
+  const std::size_t r=r_it==rank.end()?0:r_it->second;
+
+  queue.insert(
+    std::make_pair(
+      std::make_pair(r, l->location_number),
+      entryt(l, &goto_program)));
+}
+
+/// Computes the fixed point of all functions reachable from the entry
+/// point with a single work queue. The functions are processed callees
+/// first, and hence the body of a function is analysed for the merged
+/// states of all its call sites that are known so far, rather than once
+/// per change at each call site. The call sites of a function are
+/// revisited whenever the state at the end of the function changes.
+/// The queue is drained by a single thread: the domains of different
+/// functions hold ireps that share subtrees, and the reference counts of
+/// irept are not atomic. Unlike verification results, the abstract
+/// states cannot be passed back from worker processes either.
+void ai_baset::call_graph_fixedpoint(
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  const irep_idt entry=goto_functions.entry_point();
+
+  goto_functionst::function_mapt::const_iterator
+    f_it=goto_functions.function_map.find(entry);
+
+  if(f_it==goto_functions.function_map.end() ||
+     f_it->second.body.instructions.empty())
+    return;
+
+  call_graph_worklistt worklist;
+
+  {
+    const call_grapht call_graph(goto_functions);
+
+    typedef std::pair<irep_idt, call_grapht::grapht::const_iterator>
+      stack_entryt;
+    std::vector<stack_entryt> stack;
+    stack.push_back(stack_entryt(entry, call_graph.graph.lower_bound(entry)));
+
+    std::unordered_set<irep_idt, irep_id_hash> visited;
+    visited.insert(entry);
+
+    while(!stack.empty())
+    {
+      stack_entryt &top=stack.back();
+
+      if(top.second==call_graph.graph.end() ||
+         top.second->first!=top.first)
+      {
+        const std::size_t r=worklist.rank.size();
+        worklist.rank[top.first]=r;
+        stack.pop_back();
+        continue;
+      }
+
+      const irep_idt callee=top.second->second;
+      ++top.second;
+
+      if(visited.insert(callee).second)
+        stack.push_back(
+          stack_entryt(callee, call_graph.graph.lower_bound(callee)));
+    }
+  }
+
+  worklist.put(f_it->second.body.instructions.begin(), f_it->second.body);
+
+  while(!worklist.queue.empty())
+  {
+    const call_graph_worklistt::entryt next=
+      worklist.queue.begin()->second;
+    worklist.queue.erase(worklist.queue.begin());
+
+    visit(next.first, worklist, *next.second, goto_functions, ns);
+  }
+}
+
+bool ai_baset::visit(
+  locationt l,
+  call_graph_worklistt &worklist,
+  const goto_programt &goto_program,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  bool new_data=false;
+
+  statet &current=get_state(l);
+
+  for(const auto &to_l : goto_program.get_successors(l))
+  {
+    if(to_l==goto_program.instructions.end())
+      continue;
+
+    bool have_new_values=false;
+
+    if(l->is_function_call())
+    {
+      const code_function_callt &code=
+        to_code_function_call(l->code);
+
+      // initialize state, if necessary
+      get_state(to_l);
+
+      if(do_function_call_rec(
+          l, to_l,
+          goto_program,
+          code.function(),
+          worklist,
+          goto_functions, ns))
+        have_new_values=true;
+    }
+    else
+    {
+      std::unique_ptr<statet> tmp_state(
+        make_temporary_state(current));
+
+      // initialize state, if necessary
+      get_state(to_l);
+
+      tmp_state->transform(
+        l, to_l, *this, ns, ai_domain_baset::edge_typet::FUNCTION_LOCAL);
+
+      if(merge(*tmp_state, l, to_l))
+        have_new_values=true;
+    }
+
+    if(have_new_values)
+    {
+      new_data=true;
+      worklist.put(to_l, goto_program);
+
+      // the callers need to pick up the new state at the end
+      if(to_l->is_end_function())
+        for(const auto &call_site : worklist.call_sites[to_l->function])
+          worklist.put(call_site.second.first, *call_site.second.second);
+    }
+  }
+
+  return new_data;
+}
+
+bool ai_baset::do_function_call_rec(
+  locationt l_call, locationt l_return,
+  const goto_programt &goto_program,
+  const exprt &function,
+  call_graph_worklistt &worklist,
+  const goto_functionst &goto_functions,
+  const namespacet &ns)
+{
+  if(function.id()==ID_if)
+  {
+    if(function.operands().size()!=3)
+      throw "if has three operands";
+
+    bool new_data1=
+      do_function_call_rec(
+        l_call, l_return, goto_program, function.op1(),
+        worklist, goto_functions, ns);
+
+    bool new_data2=
+      do_function_call_rec(
+        l_call, l_return, goto_program, function.op2(),
+        worklist, goto_functions, ns);
+
+    return new_data1 || new_data2;
+  }
+  else if(function.id()==ID_dereference ||
+          function.id()=="NULL-object" ||
+          function.id()==ID_member ||
+          function.id()==ID_index)
+  {
+    // ignore, see do_function_call_rec above
+    return false;
+  }
+  else if(function.id()!=ID_symbol)
+  {
+    throw "unexpected function_call argument: "+
+      function.id_string();
+  }
+
+  const irep_idt &identifier=function.get(ID_identifier);
+
+  goto_functionst::function_mapt::const_iterator it=
+    goto_functions.function_map.find(identifier);
+
+  if(it==goto_functions.function_map.end())
+    throw "failed to find function "+id2string(identifier);
+
+  const goto_programt &body=it->second.body;
+
+  if(!it->second.body_available())
+  {
+    // if we don't have a body, we just do an edge call -> return
+    std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
+    tmp_state->transform(
+      l_call, l_return, *this, ns, ai_domain_baset::edge_typet::FUNCTION_LOCAL);
+
+    return merge(*tmp_state, l_call, l_return);
+  }
+
+  worklist.call_sites[identifier][l_call->location_number]=
+    call_graph_worklistt::entryt(l_call, &goto_program);
+
+  // This is the edge from call site to function head; the body is
+  // analysed by the work queue.
+
+  {
+    locationt l_begin=body.instructions.begin();
+    // initialize state, if necessary
+    get_state(l_begin);
+
+    std::unique_ptr<statet> tmp_state(make_temporary_state(get_state(l_call)));
+    tmp_state->transform(
+      l_call, l_begin, *this, ns, ai_domain_baset::edge_typet::CALL);
+
+    if(merge(*tmp_state, l_call, l_begin))
+      worklist.put(l_begin, body);
+  }
+
+  // This is the edge from function end to return site, using what is
+  // known about the end of the function so far.
+
+  locationt l_end=--body.instructions.end();
+  assert(l_end->is_end_function());
+
+  const statet &end_state=get_state(l_end);
+
+  if(end_state.is_bottom())
+    return false; // function exit point not reachable (yet)
+
+  std::unique_ptr<statet> tmp_state(make_temporary_state(end_state));
+  tmp_state->transform(
+    l_end, l_return, *this, ns, ai_domain_baset::edge_typet::RETURN);
+
+  return merge(*tmp_state, l_end, l_return);
+}
+
 void ai_baset::concurrent_fixedpoint(
   const goto_functionst &goto_functions,
   const namespacet &ns)
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 #include <util/json.h>
 #include <util/xml.h>
@@ -125,7 +126,7 @@ public:
   typedef ai_domain_baset statet;
   typedef goto_programt::const_targett locationt;
 
-  ai_baset()
+  ai_baset():use_call_graph_worklist(false)
   {
   }
 
@@ -133,6 +134,15 @@ public:
   {
   }
 
+  /// Analyse all functions with a single work queue that is ordered by
+  /// the call graph, instead of computing the fixed point of the body of
+  /// a function anew each time the state at one of its call sites
+  /// changes. Only affects the analysis of entire programs.
+  void set_call_graph_worklist(bool value)
+  {
+    use_call_graph_worklist=value;
+  }
+
   void operator()(
     const goto_programt &goto_program,
     const namespacet &ns)
@@ -312,6 +322,8 @@ protected:
       std::pair<unsigned, locationt>(l->location_number, l));
   }
 
+  bool use_call_graph_worklist;
+
   // true = found something new
   bool fixedpoint(
     const goto_programt &goto_program,
@@ -329,6 +341,45 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  // the work-queue shared by all functions is sorted by the rank of
+  // the function in the call graph, and then by location number
+  struct call_graph_worklistt
+  {
+    typedef std::pair<locationt, const goto_programt *> entryt;
+
+    std::map<std::pair<std::size_t, unsigned>, entryt> queue;
+
+    // functions are ranked in post-order from the entry point,
+    // i.e., callees come first
+    std::unordered_map<irep_idt, std::size_t, irep_id_hash> rank;
+
+    // the call sites of each function, sorted by location number
+    std::unordered_map<irep_idt, std::map<unsigned, entryt>, irep_id_hash>
+      call_sites;
+
+    void put(locationt l, const goto_programt &goto_program);
+  };
+
+  void call_graph_fixedpoint(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  // true = found something new
+  bool visit(
+    locationt l,
+    call_graph_worklistt &worklist,
+    const goto_programt &goto_program,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
+  bool do_function_call_rec(
+    locationt l_call, locationt l_return,
+    const goto_programt &goto_program,
+    const exprt &function,
+    call_graph_worklistt &worklist,
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+
   // true = found something new
   bool visit(
     locationt l,
@@ -446,7 +497,10 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns) override
   {
-    sequential_fixedpoint(goto_functions, ns);
+    if(use_call_graph_worklist)
+      call_graph_fixedpoint(goto_functions, ns);
+    else
+      sequential_fixedpoint(goto_functions, ns);
   }
 
 private:
@@ -16,27 +16,249 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <iostream>
 
+const std::size_t custom_bitvector_domaint::bit_vectort::word_bits;
+
+custom_bitvector_domaint::bit_vectort
+  custom_bitvector_domaint::bitst::get(std::size_t object) const
+{
+  bit_vectort result;
+
+  if(object<objects())
+  {
+    auto first=data->words.begin()+object*data->words_per_object;
+    result.words.assign(first, first+data->words_per_object);
+  }
+
+  return result;
+}
+
+custom_bitvector_domaint::bitst::tablet &
+  custom_bitvector_domaint::bitst::detach(
+    std::size_t objects,
+    std::size_t words_per_object)
+{
+  if(data==nullptr)
+    data=std::make_shared<tablet>();
+  else if(data.use_count()==1 &&
+          objects<=data->objects &&
+          words_per_object<=data->words_per_object)
+    return *data;
+
+  const tablet &old=*data;
+  auto table=std::make_shared<tablet>();
+
+  table->objects=std::max(objects, old.objects);
+  table->words_per_object=std::max(words_per_object, old.words_per_object);
+
+  if(table->words_per_object==old.words_per_object)
+  {
+    table->words=old.words;
+    table->words.resize(table->objects*table->words_per_object, 0);
+  }
+  else
+  {
+    table->words.resize(table->objects*table->words_per_object, 0);
+    for(std::size_t o=0; o<old.objects; o++)
+      std::copy(
+        old.words.begin()+o*old.words_per_object,
+        old.words.begin()+(o+1)*old.words_per_object,
+        table->words.begin()+o*table->words_per_object);
+  }
+
+  data=table;
+  return *table;
+}
+
+custom_bitvector_domaint::bitst::wordt *
+  custom_bitvector_domaint::bitst::write(
+    std::size_t object,
+    std::size_t objects,
+    std::size_t words_per_object)
+{
+  tablet &table=detach(std::max(object+1, objects), words_per_object);
+  return table.words.data()+object*table.words_per_object;
+}
+
+bool custom_bitvector_domaint::bitst::has_bit(unsigned bit_nr) const
+{
+  const std::size_t w=bit_nr/bit_vectort::word_bits;
+  const wordt mask=wordt(1)<<(bit_nr%bit_vectort::word_bits);
+
+  for(std::size_t o=0; o<objects(); o++)
+    if((word(o, w)&mask)!=0)
+      return true;
+
+  return false;
+}
+
+void custom_bitvector_domaint::bitst::clear_bit(unsigned bit_nr)
+{
+  // don't modify a shared table unless the bit is set
+  if(!has_bit(bit_nr))
+    return;
+
+  const std::size_t w=bit_nr/bit_vectort::word_bits;
+  const wordt mask=wordt(1)<<(bit_nr%bit_vectort::word_bits);
+
+  tablet &table=detach(0, 0);
+
+  for(std::size_t o=0; o<table.objects; o++)
+    table.words[o*table.words_per_object+w]&=~mask;
+}
+
+/// Sets the bits that are set in \p other
+/// \return true iff the table has changed
+bool custom_bitvector_domaint::bitst::merge_union(const bitst &other)
+{
+  if(other.data==nullptr || data==other.data)
+    return false;
+
+  if(data==nullptr)
+  {
+    data=other.data;
+    return true;
+  }
+
+  const tablet &a=*data;
+  const tablet &b=*other.data;
+
+  if(a.objects==b.objects && a.words_per_object==b.words_per_object)
+  {
+    // the common case: a pass over the arrays that the compiler can
+    // vectorize
+    const std::size_t size=a.words.size();
+    std::size_t i=0;
+
+    while(i<size && (b.words[i]&~a.words[i])==0)
+      i++;
+
+    if(i==size)
+      return false;
+
+    wordt *dest=detach(0, 0).words.data();
+    const wordt *src=b.words.data();
+
+    for(; i<size; i++)
+      dest[i]|=src[i];
+
+    return true;
+  }
+
+  bool changed=false;
+
+  for(std::size_t o=0; o<b.objects && !changed; o++)
+    for(std::size_t w=0; w<b.words_per_object; w++)
+      if((b.words[o*b.words_per_object+w]&~word(o, w))!=0)
+      {
+        changed=true;
+        break;
+      }
+
+  if(!changed)
+    return false;
+
+  tablet &dest=detach(b.objects, b.words_per_object);
+
+  for(std::size_t o=0; o<b.objects; o++)
+    for(std::size_t w=0; w<b.words_per_object; w++)
+      dest.words[o*dest.words_per_object+w]|=
+        b.words[o*b.words_per_object+w];
+
+  return true;
+}
+
+/// Clears the bits that are not set in \p other
+/// \return true iff the table has changed
+bool custom_bitvector_domaint::bitst::merge_intersection(const bitst &other)
+{
+  if(data==nullptr || data==other.data)
+    return false;
+
+  const tablet &a=*data;
+
+  if(other.data==nullptr)
+  {
+    for(const auto w : a.words)
+      if(w!=0)
+      {
+        data.reset();
+        return true;
+      }
+
+    return false;
+  }
+
+  const tablet &b=*other.data;
+
+  if(a.objects==b.objects && a.words_per_object==b.words_per_object)
+  {
+    const std::size_t size=a.words.size();
+    std::size_t i=0;
+
+    while(i<size && (a.words[i]&~b.words[i])==0)
+      i++;
+
+    if(i==size)
+      return false;
+
+    wordt *dest=detach(0, 0).words.data();
+    const wordt *src=b.words.data();
+
+    for(; i<size; i++)
+      dest[i]&=src[i];
+
+    return true;
+  }
+
+  bool changed=false;
+
+  for(std::size_t o=0; o<a.objects && !changed; o++)
+    for(std::size_t w=0; w<a.words_per_object; w++)
+      if((a.words[o*a.words_per_object+w]&~other.word(o, w))!=0)
+      {
+        changed=true;
+        break;
+      }
+
+  if(!changed)
+    return false;
+
+  tablet &dest=detach(0, 0);
+
+  for(std::size_t o=0; o<dest.objects; o++)
+    for(std::size_t w=0; w<dest.words_per_object; w++)
+      dest.words[o*dest.words_per_object+w]&=other.word(o, w);
+
+  return true;
+}
+
 void custom_bitvector_domaint::set_bit(
-  const irep_idt &identifier,
+  std::size_t object,
   unsigned bit_nr,
-  modet mode)
+  modet mode,
+  const custom_bitvector_analysist &cba)
 {
+  bitst &bits=
+    (mode==modet::SET_MUST || mode==modet::CLEAR_MUST)?must_bits:may_bits;
+
+  const std::size_t w=bit_nr/bit_vectort::word_bits;
+  const bitst::wordt mask=bitst::wordt(1)<<(bit_nr%bit_vectort::word_bits);
+
   switch(mode)
   {
   case modet::SET_MUST:
-    set_bit(must_bits[identifier], bit_nr);
-    break;
-
-  case modet::CLEAR_MUST:
-    clear_bit(must_bits[identifier], bit_nr);
-    break;
-
   case modet::SET_MAY:
-    set_bit(may_bits[identifier], bit_nr);
+    bits.write(
+      object,
+      cba.objects.size(),
+      std::max(w+1, cba.words_per_object()))[w]|=mask;
     break;
 
+  case modet::CLEAR_MUST:
   case modet::CLEAR_MAY:
-    clear_bit(may_bits[identifier], bit_nr);
+    // don't modify a shared table unless the bit is set
+    if((bits.word(object, w)&mask)!=0)
+      bits.write(object, 0, 0)[w]&=~mask;
     break;
   }
 }
@@ -44,11 +266,12 @@ void custom_bitvector_domaint::set_bit(
 void custom_bitvector_domaint::set_bit(
   const exprt &lhs,
   unsigned bit_nr,
-  modet mode)
+  modet mode,
+  custom_bitvector_analysist &cba)
 {
   irep_idt id=object2id(lhs);
   if(!id.empty())
-    set_bit(id, bit_nr, mode);
+    set_bit(cba.objects.number(id), bit_nr, mode, cba);
 }
 
 irep_idt custom_bitvector_domaint::object2id(const exprt &src)
@@ -105,64 +328,78 @@ irep_idt custom_bitvector_domaint::object2id(const exprt &src)
 
 void custom_bitvector_domaint::assign_lhs(
   const exprt &lhs,
-  const vectorst &vectors)
+  const vectorst &vectors,
+  custom_bitvector_analysist &cba)
 {
   irep_idt id=object2id(lhs);
   if(!id.empty())
-    assign_lhs(id, vectors);
+    assign_lhs(cba.objects.number(id), vectors, cba);
 }
 
-void custom_bitvector_domaint::assign_lhs(
-  const irep_idt &identifier,
-  const vectorst &vectors)
+/// Overwrites the bits of \p object in \p bits with \p vector
+static void assign_bits(
+  custom_bitvector_domaint::bitst &bits,
+  std::size_t object,
+  const custom_bitvector_domaint::bit_vectort &vector,
+  const custom_bitvector_analysist &cba)
 {
-  // we erase blank ones to avoid noise
+  // don't grow or modify a shared table for blank vectors of
+  // objects that have none
+  if(vector.is_zero() && bits.get(object).is_zero())
+    return;
 
-  if(vectors.must_bits==0)
-    must_bits.erase(identifier);
-  else
-    must_bits[identifier]=vectors.must_bits;
+  const std::size_t words_per_object=
+    std::max(vector.words.size(), cba.words_per_object());
 
-  if(vectors.may_bits==0)
-    may_bits.erase(identifier);
-  else
-    may_bits[identifier]=vectors.may_bits;
+  custom_bitvector_domaint::bitst::wordt *dest=
+    bits.write(object, cba.objects.size(), words_per_object);
+
+  std::fill(dest, dest+words_per_object, 0);
+  std::copy(vector.words.begin(), vector.words.end(), dest);
+}
+
+void custom_bitvector_domaint::assign_lhs(
+  std::size_t object,
+  const vectorst &vectors,
+  const custom_bitvector_analysist &cba)
+{
+  assign_bits(must_bits, object, vectors.must_bits, cba);
+  assign_bits(may_bits, object, vectors.may_bits, cba);
 }
 
 custom_bitvector_domaint::vectorst
-  custom_bitvector_domaint::get_rhs(const irep_idt &identifier) const
+  custom_bitvector_domaint::get_rhs(std::size_t object) const
 {
   vectorst vectors;
 
-  bitst::const_iterator may_it=may_bits.find(identifier);
-  if(may_it!=may_bits.end())
-    vectors.may_bits=may_it->second;
-
-  bitst::const_iterator must_it=must_bits.find(identifier);
-  if(must_it!=must_bits.end())
-    vectors.must_bits=must_it->second;
+  vectors.may_bits=may_bits.get(object);
+  vectors.must_bits=must_bits.get(object);
 
   return vectors;
 }
 
 custom_bitvector_domaint::vectorst
-  custom_bitvector_domaint::get_rhs(const exprt &rhs) const
+  custom_bitvector_domaint::get_rhs(
+    const exprt &rhs,
+    const custom_bitvector_analysist &cba) const
 {
   if(rhs.id()==ID_symbol ||
      rhs.id()==ID_dereference)
   {
     const irep_idt identifier=object2id(rhs);
-    return get_rhs(identifier);
+    const auto object=cba.objects.get_number(identifier);
+    if(object.has_value())
+      return get_rhs(*object);
   }
   else if(rhs.id()==ID_typecast)
   {
-    return get_rhs(to_typecast_expr(rhs).op());
+    return get_rhs(to_typecast_expr(rhs).op(), cba);
   }
   else if(rhs.id()==ID_if)
   {
     // need to merge both
-    vectorst v_true=get_rhs(to_if_expr(rhs).true_case());
-    vectorst v_false=get_rhs(to_if_expr(rhs).false_case());
+    vectorst v_true=get_rhs(to_if_expr(rhs).true_case(), cba);
+    vectorst v_false=get_rhs(to_if_expr(rhs).false_case(), cba);
     return merge(v_true, v_false);
   }
 
@@ -247,11 +484,11 @@ void custom_bitvector_domaint::assign_struct_rec(
     // may alias other stuff
     std::set<exprt> lhs_set=cba.aliases(lhs, from);
 
-    vectorst rhs_vectors=get_rhs(rhs);
+    vectorst rhs_vectors=get_rhs(rhs, cba);
 
     for(const auto &lhs_alias : lhs_set)
     {
-      assign_lhs(lhs_alias, rhs_vectors);
+      assign_lhs(lhs_alias, rhs_vectors, cba);
     }
 
     // is it a pointer?
@@ -259,8 +496,8 @@ void custom_bitvector_domaint::assign_struct_rec(
     {
       dereference_exprt lhs_deref(lhs);
       dereference_exprt rhs_deref(rhs);
-      vectorst rhs_vectors=get_rhs(rhs_deref);
-      assign_lhs(lhs_deref, rhs_vectors);
+      vectorst rhs_vectors=get_rhs(rhs_deref, cba);
+      assign_lhs(lhs_deref, rhs_vectors, cba);
     }
   }
 }
@@ -290,22 +527,22 @@ void custom_bitvector_domaint::transform(
   case DECL:
     {
       const code_declt &code_decl=to_code_decl(instruction.code);
-      assign_lhs(code_decl.symbol(), vectorst());
+      assign_lhs(code_decl.symbol(), vectorst(), cba);
 
       // is it a pointer?
       if(code_decl.symbol().type().id()==ID_pointer)
-        assign_lhs(dereference_exprt(code_decl.symbol()), vectorst());
+        assign_lhs(dereference_exprt(code_decl.symbol()), vectorst(), cba);
     }
     break;
 
   case DEAD:
     {
       const code_deadt &code_dead=to_code_dead(instruction.code);
-      assign_lhs(code_dead.symbol(), vectorst());
+      assign_lhs(code_dead.symbol(), vectorst(), cba);
 
       // is it a pointer?
       if(code_dead.symbol().type().id()==ID_pointer)
-        assign_lhs(dereference_exprt(code_dead.symbol()), vectorst());
+        assign_lhs(dereference_exprt(code_dead.symbol()), vectorst(), cba);
     }
     break;
 
@@ -350,21 +587,9 @@ void custom_bitvector_domaint::transform(
                  to_constant_expr(lhs).get_value()==ID_NULL) // NULL means all
               {
                 if(mode==modet::CLEAR_MAY)
-                {
-                  for(auto &bit : may_bits)
-                    clear_bit(bit.second, bit_nr);
-
-                  // erase blank ones
-                  erase_blank_vectors(may_bits);
-                }
+                  may_bits.clear_bit(bit_nr);
                 else if(mode==modet::CLEAR_MUST)
-                {
-                  for(auto &bit : must_bits)
-                    clear_bit(bit.second, bit_nr);
-
-                  // erase blank ones
-                  erase_blank_vectors(must_bits);
-                }
+                  must_bits.clear_bit(bit_nr);
               }
               else
               {
@@ -375,7 +600,7 @@ void custom_bitvector_domaint::transform(
 
                 for(const auto &lhs : lhs_set)
                 {
-                  set_bit(lhs, bit_nr, mode);
+                  set_bit(lhs, bit_nr, mode, cba);
                 }
               }
             }
@@ -419,11 +644,11 @@ void custom_bitvector_domaint::transform(
               // may alias other stuff
               std::set<exprt> lhs_set=cba.aliases(p, from);
 
-              vectorst rhs_vectors=get_rhs(*arg_it);
+              vectorst rhs_vectors=get_rhs(*arg_it, cba);
 
               for(const auto &lhs : lhs_set)
               {
-                assign_lhs(lhs, rhs_vectors);
+                assign_lhs(lhs, rhs_vectors, cba);
               }
 
               // is it a pointer?
@@ -431,13 +656,15 @@ void custom_bitvector_domaint::transform(
               {
                 dereference_exprt lhs_deref(p);
                 dereference_exprt rhs_deref(*arg_it);
-                vectorst rhs_vectors=get_rhs(rhs_deref);
-                assign_lhs(lhs_deref, rhs_vectors);
+                vectorst rhs_vectors=get_rhs(rhs_deref, cba);
+                assign_lhs(lhs_deref, rhs_vectors, cba);
               }
 
               ++arg_it;
             }
           }
+          else
+            cba.transform_local_call(from, *this);
         }
       }
     }
@@ -478,25 +705,9 @@ void custom_bitvector_domaint::transform(
              to_constant_expr(lhs).get_value()==ID_NULL) // NULL means all
           {
             if(mode==modet::CLEAR_MAY)
-            {
-              for(bitst::iterator b_it=may_bits.begin();
-                  b_it!=may_bits.end();
-                  b_it++)
-                clear_bit(b_it->second, bit_nr);
-
-              // erase blank ones
-              erase_blank_vectors(may_bits);
-            }
+              may_bits.clear_bit(bit_nr);
             else if(mode==modet::CLEAR_MUST)
-            {
-              for(bitst::iterator b_it=must_bits.begin();
-                  b_it!=must_bits.end();
-                  b_it++)
-                clear_bit(b_it->second, bit_nr);
-
-              // erase blank ones
-              erase_blank_vectors(must_bits);
-            }
+              must_bits.clear_bit(bit_nr);
           }
           else
           {
@@ -507,7 +718,7 @@ void custom_bitvector_domaint::transform(
 
             for(const auto &lhs : lhs_set)
             {
-              set_bit(lhs, bit_nr, mode);
+              set_bit(lhs, bit_nr, mode, cba);
             }
           }
         }
@@ -551,13 +762,16 @@ void custom_bitvector_domaint::output(
   const custom_bitvector_analysist &cba=
     static_cast<const custom_bitvector_analysist &>(ai);
 
-  for(const auto &bit : may_bits)
+  for(std::size_t o=0; o<may_bits.objects(); o++)
   {
-    out << bit.first << " MAY:";
-    bit_vectort b=bit.second;
+    bit_vectort b=may_bits.get(o);
+    if(b.is_zero())
+      continue;
 
-    for(unsigned i=0; b!=0; i++, b>>=1)
-      if(b&1)
+    out << cba.objects[o] << " MAY:";
+
+    for(unsigned i=0; i<b.words.size()*bit_vectort::word_bits; i++)
+      if(b.get_bit(i))
       {
         assert(i<cba.bits.size());
         out << ' '
@@ -567,13 +781,16 @@ void custom_bitvector_domaint::output(
     out << '\n';
   }
 
-  for(const auto &bit : must_bits)
+  for(std::size_t o=0; o<must_bits.objects(); o++)
   {
-    out << bit.first << " MUST:";
-    bit_vectort b=bit.second;
+    bit_vectort b=must_bits.get(o);
+    if(b.is_zero())
+      continue;
+
+    out << cba.objects[o] << " MUST:";
 
-    for(unsigned i=0; b!=0; i++, b>>=1)
-      if(b&1)
+    for(unsigned i=0; i<b.words.size()*bit_vectort::word_bits; i++)
+      if(b.get_bit(i))
       {
         assert(i<cba.bits.size());
         out << ' '
@@ -590,78 +807,27 @@ bool custom_bitvector_domaint::merge(
   locationt to)
 {
   bool changed=has_values.is_false();
-  has_values=tvt::unknown();
 
-  // first do MAY
-  bitst::iterator it=may_bits.begin();
-  for(const auto &bit : b.may_bits)
+  if(has_values.is_false())
   {
-    while(it!=may_bits.end() && it->first<bit.first)
-      ++it;
-    if(it==may_bits.end() || bit.first<it->first)
-    {
-      may_bits.insert(it, bit);
-      changed=true;
-    }
-    else if(it!=may_bits.end())
-    {
-      bit_vectort &a_bits=it->second;
-      bit_vectort old=a_bits;
-      a_bits|=bit.second;
-      if(old!=a_bits)
-        changed=true;
-
-      ++it;
-    }
+    // share the tables of b
+    may_bits=b.may_bits;
+    must_bits=b.must_bits;
   }
-
-  // now do MUST
-  it=must_bits.begin();
-  for(auto &bit : b.must_bits)
+  else if(!b.has_values.is_false())
   {
-    while(it!=must_bits.end() && it->first<bit.first)
-    {
-      it=must_bits.erase(it);
-      changed=true;
-    }
-    if(it==must_bits.end() || bit.first<it->first)
-    {
-      must_bits.insert(it, bit);
+    if(may_bits.merge_union(b.may_bits))
       changed=true;
-    }
-    else if(it!=must_bits.end())
-    {
-      bit_vectort &a_bits=it->second;
-      bit_vectort old=a_bits;
-      a_bits&=bit.second;
-      if(old!=a_bits)
-        changed=true;
 
-      ++it;
-    }
+    if(must_bits.merge_intersection(b.must_bits))
+      changed=true;
   }
 
-  // erase blank ones
-  erase_blank_vectors(may_bits);
-  erase_blank_vectors(must_bits);
+  has_values=tvt::unknown();
 
   return changed;
 }
 
-/// erase blank bitvectors
-void custom_bitvector_domaint::erase_blank_vectors(bitst &bits)
-{
-  for(bitst::iterator a_it=bits.begin();
-      a_it!=bits.end();
-     ) // no a_it++
-  {
-    if(a_it->second==0)
-      a_it=bits.erase(a_it);
-    else
-      a_it++;
-  }
-}
-
 bool custom_bitvector_domaint::has_get_must_or_may(const exprt &src)
 {
   if(src.id()=="get_must" ||
@@ -696,9 +862,8 @@ exprt custom_bitvector_domaint::eval(
       {
         if(src.id()=="get_may")
         {
-          for(const auto &bit : may_bits)
-            if(get_bit(bit.second, bit_nr))
-              return true_exprt();
+          if(may_bits.has_bit(bit_nr))
+            return true_exprt();
 
           return false_exprt();
         }
@@ -712,14 +877,14 @@ exprt custom_bitvector_domaint::eval(
       else
       {
         custom_bitvector_domaint::vectorst v=
-          get_rhs(dereference_exprt(pointer));
+          get_rhs(dereference_exprt(pointer), custom_bitvector_analysis);
 
         bool value=false;
 
         if(src.id()=="get_must")
-          value=get_bit(v.must_bits, bit_nr);
+          value=v.must_bits.get_bit(bit_nr);
         else if(src.id()=="get_may")
-          value=get_bit(v.may_bits, bit_nr);
+          value=v.may_bits.get_bit(bit_nr);
 
         if(value)
           return true_exprt();
@@ -12,6 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_CUSTOM_BITVECTOR_ANALYSIS_H
 #define CPROVER_ANALYSES_CUSTOM_BITVECTOR_ANALYSIS_H
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include <util/numbering.h>
 #include <util/threeval.h>
 
@@ -75,23 +79,121 @@ public:
     locationt from,
     locationt to);
 
-  typedef unsigned long long bit_vectort;
+  /// A bit vector of unbounded width; missing words are zero
+  class bit_vectort
+  {
+  public:
+    typedef unsigned long long wordt;
+    static const std::size_t word_bits=sizeof(wordt)*8;
 
-  typedef std::map<irep_idt, bit_vectort> bitst;
+    std::vector<wordt> words;
 
-  struct vectorst
+    bool get_bit(unsigned bit_nr) const
+    {
+      std::size_t w=bit_nr/word_bits;
+      return w<words.size() && (words[w]&(wordt(1)<<(bit_nr%word_bits)))!=0;
+    }
+
+    void set_bit(unsigned bit_nr)
+    {
+      std::size_t w=bit_nr/word_bits;
+      if(w>=words.size())
+        words.resize(w+1, 0);
+      words[w]|=wordt(1)<<(bit_nr%word_bits);
+    }
+
+    bool is_zero() const
+    {
+      for(const auto w : words)
+        if(w!=0)
+          return false;
+      return true;
+    }
+  };
+
+  /// The bit vectors of all objects, indexed by the object numbers of
+  /// custom_bitvector_analysist. The words of all objects are kept in
+  /// one array with a fixed number of words per object, which makes
+  /// merges a single pass over the array. The array is shared by the
+  /// copies of a domain until one of them modifies it.
+  class bitst
   {
-    bit_vectort may_bits, must_bits;
-    vectorst():may_bits(0), must_bits(0)
+  public:
+    typedef bit_vectort::wordt wordt;
+
+    bool empty() const
     {
+      return data==nullptr;
     }
+
+    void clear()
+    {
+      data.reset();
+    }
+
+    std::size_t objects() const
+    {
+      return data==nullptr?0:data->objects;
+    }
+
+    wordt word(std::size_t object, std::size_t w) const
+    {
+      if(object>=objects() || w>=data->words_per_object)
+        return 0;
+      return data->words[object*data->words_per_object+w];
+    }
+
+    bit_vectort get(std::size_t object) const;
+
+    /// \return the words of the given object for modification, after
+    ///   growing the table to the given size
+    wordt *write(
+      std::size_t object,
+      std::size_t objects,
+      std::size_t words_per_object);
+
+    bool has_bit(unsigned bit_nr) const;
+    void clear_bit(unsigned bit_nr);
+
+    bool merge_union(const bitst &);
+    bool merge_intersection(const bitst &);
+
+  protected:
+    struct tablet
+    {
+      std::size_t objects, words_per_object;
+      std::vector<wordt> words;
+
+      tablet():objects(0), words_per_object(0)
+      {
+      }
+    };
+
+    std::shared_ptr<tablet> data;
+
+    tablet &detach(std::size_t objects, std::size_t words_per_object);
+  };
+
+  struct vectorst
+  {
+    bit_vectort may_bits, must_bits;
   };
 
   static vectorst merge(const vectorst &a, const vectorst &b)
   {
     vectorst result;
-    result.may_bits=a.may_bits|b.may_bits;
-    result.must_bits=a.must_bits&b.must_bits;
+    const std::size_t size=
+      std::max(a.may_bits.words.size(), b.may_bits.words.size());
+    result.may_bits.words.resize(size, 0);
+    for(std::size_t i=0; i<a.may_bits.words.size(); i++)
+      result.may_bits.words[i]|=a.may_bits.words[i];
+    for(std::size_t i=0; i<b.may_bits.words.size(); i++)
+      result.may_bits.words[i]|=b.may_bits.words[i];
+
+    result.must_bits.words.resize(
+      std::min(a.must_bits.words.size(), b.must_bits.words.size()));
+    for(std::size_t i=0; i<result.must_bits.words.size(); i++)
+      result.must_bits.words[i]=a.must_bits.words[i]&b.must_bits.words[i];
     return result;
   }
 
@@ -104,10 +206,16 @@ public:
     custom_bitvector_analysist &,
     const namespacet &);
 
-  void assign_lhs(const exprt &, const vectorst &);
-  void assign_lhs(const irep_idt &, const vectorst &);
-  vectorst get_rhs(const exprt &) const;
-  vectorst get_rhs(const irep_idt &) const;
+  void assign_lhs(
+    const exprt &,
+    const vectorst &,
+    custom_bitvector_analysist &);
+  void assign_lhs(
+    std::size_t object,
+    const vectorst &,
+    const custom_bitvector_analysist &);
+  vectorst get_rhs(const exprt &, const custom_bitvector_analysist &) const;
+  vectorst get_rhs(std::size_t object) const;
 
   tvt has_values;
 
@@ -120,31 +228,21 @@ public:
     const exprt &src,
     custom_bitvector_analysist &) const;
 
+  static irep_idt object2id(const exprt &);
+
 private:
   enum class modet { SET_MUST, CLEAR_MUST, SET_MAY, CLEAR_MAY };
 
-  void set_bit(const exprt &, unsigned bit_nr, modet);
-  void set_bit(const irep_idt &, unsigned bit_nr, modet);
-
-  static inline void set_bit(bit_vectort &dest, unsigned bit_nr)
-  {
-    dest|=(1ll<<bit_nr);
-  }
-
-  static inline void clear_bit(bit_vectort &dest, unsigned bit_nr)
-  {
-    dest|=(1ll<<bit_nr);
-    dest^=(1ll<<bit_nr);
-  }
-
-  static inline bool get_bit(const bit_vectort src, unsigned bit_nr)
-  {
-    return (src&(1ll<<bit_nr))!=0;
-  }
-
-  void erase_blank_vectors(bitst &);
-
-  static irep_idt object2id(const exprt &);
+  void set_bit(
+    const exprt &,
+    unsigned bit_nr,
+    modet,
+    custom_bitvector_analysist &);
+  void set_bit(
+    std::size_t object,
+    unsigned bit_nr,
+    modet,
+    const custom_bitvector_analysist &);
 };
 
 class custom_bitvector_analysist:public ait<custom_bitvector_domaint>
@@ -162,9 +260,28 @@ public:
 
   unsigned get_bit_nr(const exprt &);
 
+  /// Applies the effect of a call to a function that is not analysed
+  /// along with its caller, e.g., because it has no body or because the
+  /// analysis is intraprocedural. The default is to do nothing.
+  virtual void transform_local_call(locationt call, custom_bitvector_domaint &)
+  {
+  }
+
   typedef numbering<irep_idt> bitst;
   bitst bits;
 
+  /// the objects that have bits, which index the rows of
+  /// custom_bitvector_domaint::bitst
+  typedef hash_numbering<irep_idt, irep_id_hash> objectst;
+  objectst objects;
+
+  /// \return the number of words that hold the bits numbered so far
+  std::size_t words_per_object() const
+  {
+    typedef custom_bitvector_domaint::bit_vectort bit_vectort;
+    return (bits.size()+bit_vectort::word_bits-1)/bit_vectort::word_bits;
+  }
+
 protected:
   virtual void initialize(const goto_functionst &_goto_functions)
   {
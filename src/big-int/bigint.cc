@@ -291,7 +291,7 @@ BigInt::reallocate (unsigned digits)
 {
   if (digits > size)
     {
-      if (size)
+      if (on_heap())
 	delete[] digit;
       size = adjust_size (digits);
       digit = new onedig_t[size];
@@ -307,13 +307,13 @@ BigInt::resize (unsigned digits)
   if (digits > size)
     {
       onedig_t *old_digit = digit;
-      unsigned old_size = size;
+      bool old_on_heap = on_heap();
       size = adjust_size (digits);
       digit = new onedig_t[size];
       if (old_digit)
 	{
 	  memcpy (digit, old_digit, length * sizeof (onedig_t));
-	  if (old_size)
+	  if (old_on_heap)
 	    delete[] old_digit;
 	}
     }
@@ -386,7 +386,7 @@ BigInt::assign (llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
+  if (on_heap())
     {
       memset (digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
       delete[] digit;
@@ -401,64 +401,64 @@ BigInt::BigInt (onedig_t *dig, unsigned len, bool pos)
 {}
 
 BigInt::BigInt()
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {}
 
 BigInt::BigInt (signed long int n)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned long int n)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (n));
 }
 
 BigInt::BigInt (int n)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned u)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (u));
 }
 
 BigInt::BigInt (llong_t l)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (l);
 }
 
 BigInt::BigInt (ullong_t ul)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ul);
 }
 
 BigInt::BigInt (BigInt const &y)
-  : size (adjust_size (y.length)),
+  : size (y.length <= inline_digits ? inline_digits : adjust_size (y.length)),
     length (y.length),
-    digit (new onedig_t[size]),
+    digit (y.length <= inline_digits ? inline_digit : new onedig_t[size]),
     positive (y.positive)
 {
   memcpy (digit, y.digit, length * sizeof (onedig_t));
@@ -471,9 +471,9 @@ BigInt::BigInt (BigInt &&y)
 }
 
 BigInt::BigInt (char const *s, onedig_t b)
-  : size (adjust_size (small)),
+  : size (inline_digits),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {
   scan (s, b);
@@ -482,8 +482,14 @@ BigInt::BigInt (char const *s, onedig_t b)
 BigInt &
 BigInt::operator= (BigInt const &y)
 {
-  BigInt copy(y);
-  swap(copy);
+  if (this != &y)
+    {
+      // Reuse the digit vector of this where possible.
+      reallocate (y.length);
+      length = y.length;
+      positive = y.positive;
+      memcpy (digit, y.digit, length * sizeof (onedig_t));
+    }
   return *this;
 }
 
@@ -872,10 +878,15 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
     }
   else
     {
-      // Get a new string of digits for the result.
-      unsigned old_size = size;
-      size = adjust_size (length + len);
-      onedig_t *r = new onedig_t[size];
+      // Get a new string of digits for the result, unless it fits
+      // into this.
+      onedig_t small_r[inline_digits];
+      bool fits = length + len <= inline_digits && length + len <= size;
+      onedig_t *r;
+      if (fits)
+	r = small_r;
+      else
+	r = new onedig_t[adjust_size (length + len)];
 
       // The first parameter pair defines the outer loop which should
       // be the shorter.
@@ -885,9 +896,15 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 	digit_mul (dig, len, digit, length, r);
 
       // Replace digit string of this with result.
-      if (old_size)
-	delete[] digit;
-      digit = r;
+      if (fits)
+	memcpy (digit, r, (length + len) * sizeof (onedig_t));
+      else
+	{
+	  if (on_heap())
+	    delete[] digit;
+	  size = adjust_size (length + len);
+	  digit = r;
+	}
       length += len;
       adjust();
     }
@@ -1092,7 +1109,7 @@ BigInt::div (BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
       onedig_t *b = (onedig_t *)alloca (bl * sizeof (onedig_t));
       memcpy (b, y.digit, bl * sizeof (onedig_t));
 
-      onedig_t scale = onedig_t (base / (1 + b[bl - 1]));
+      onedig_t scale = onedig_t (base / (1 + twodig_t (b[bl - 1])));
       if (scale != 1)
 	{
 	  if ((a[al] = digit_mul (a, al, scale)) != 0) ++al;
@@ -1105,8 +1122,8 @@ BigInt::div (BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
 	a[al++] = 0;
 
       // Prepare q for receiving the quotient.
+      q.reallocate (al - bl);
       q.length = al - bl;
-      q.resize (q.length);
 
       // Divide.
       digit_div (a, b, bl, q.digit, q.length);
@@ -1116,8 +1133,8 @@ BigInt::div (BigInt const &x, BigInt const &y, BigInt &q, BigInt &r)
       if (scale != 1)
 	digit_div (a, al, scale);
       if (al && a[al - 1] == 0) --al;
+      r.reallocate (al);
       r.length = al;
-      r.resize (r.length);
       memcpy (r.digit, a, al * sizeof (onedig_t));
     }
   q.adjust();
@@ -1175,7 +1192,7 @@ BigInt::operator/= (BigInt const &y)
       onedig_t *b = (onedig_t *)alloca (bl * sizeof (onedig_t));
       memcpy (b, y.digit, bl * sizeof (onedig_t));
 
-      onedig_t scale = onedig_t (base / (1 + b[bl - 1]));
+      onedig_t scale = onedig_t (base / (1 + twodig_t (b[bl - 1])));
       if (scale != 1)
 	{
 	  if ((a[al] = digit_mul (a, al, scale)) != 0) ++al;
@@ -1244,7 +1261,7 @@ BigInt::operator%= (BigInt const &y)
       onedig_t *b = (onedig_t *)alloca (bl * sizeof (onedig_t));
       memcpy (b, y.digit, bl * sizeof (onedig_t));
 
-      onedig_t scale = onedig_t (base / (1 + b[bl - 1]));
+      onedig_t scale = onedig_t (base / (1 + twodig_t (b[bl - 1])));
       if (scale != 1)
 	{
 	  if ((a[al] = digit_mul (a, al, scale)) != 0) ++al;
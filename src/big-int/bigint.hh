@@ -128,11 +128,20 @@ public:
   // by an elementary type.
   enum { small = sizeof (ullong_t) / sizeof (onedig_t) };
 
+  // Number of digits stored within the object itself. Values that fit
+  // into this, which covers the product of any two elementary
+  // integers, do not touch the heap.
+  enum { inline_digits = 2 * small };
+
 private:
   unsigned size;			// Length of digit vector.
   unsigned length;			// Used places in digit vector.
   onedig_t *digit;			// Least significant first.
   bool positive;			// Signed magnitude representation.
+  onedig_t inline_digit[inline_digits];	// Digit vector of small values.
+
+  // The digit vector is owned by this and has been allocated on the heap.
+  bool on_heap() const		{ return size != 0 && digit != inline_digit; }
 
   // Create or resize this.
   inline void allocate (unsigned digits);
@@ -278,10 +287,20 @@ public:
 
   void swap (BigInt &other)
   {
+    bool this_inline = digit == inline_digit;
+    bool other_inline = other.digit == other.inline_digit;
     std::swap(other.size, size);
     std::swap(other.length, length);
     std::swap(other.digit, digit);
     std::swap(other.positive, positive);
+    if (this_inline || other_inline)
+      {
+	std::swap(other.inline_digit, inline_digit);
+	if (this_inline)
+	  other.digit = other.inline_digit;
+	if (other_inline)
+	  digit = inline_digit;
+      }
   }
 };
 
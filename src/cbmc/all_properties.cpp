@@ -11,7 +11,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "all_properties_class.h"
 
-#include <util/time_stopping.h>
+#include <algorithm>
+#include <thread>
+
 #include <util/xml.h>
 #include <util/json.h>
 
@@ -50,17 +52,8 @@ void bmc_all_propertiest::goal_covered(const cover_goalst::goalt &)
   }
 }
 
-safety_checkert::resultt bmc_all_propertiest::operator()()
+void bmc_all_propertiest::collect_goals()
 {
-  status() << "Passing problem to " << solver.decision_procedure_text() << eom;
-
-  solver.set_message_handler(get_message_handler());
-
-  // stop the time
-  absolute_timet sat_start=current_time();
-
-  bmc.do_conversion();
-
   // Collect _all_ goals in `goal_map'.
   // This maps property IDs to 'goalt'
   forall_goto_functions(f_it, goto_functions)
@@ -95,6 +88,54 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
       goal_map[property_id].instances.push_back(it);
     }
   }
+}
+
+safety_checkert::resultt bmc_all_propertiest::operator()()
+{
+  status() << "Passing problem to " << solver.decision_procedure_text() << eom;
+
+  solver.set_message_handler(get_message_handler());
+
+  // stop the time
+  absolute_timet sat_start=current_time();
+
+  if(bmc.options.get_option("split-branches")!="")
+  {
+    unsigned depth=bmc.options.get_unsigned_int_option("split-branches");
+
+    // by default, one worker per core, and never more than there are cubes
+    unsigned jobs=std::max(1u, std::thread::hardware_concurrency());
+    if(bmc.options.get_option("jobs")!="")
+      jobs=bmc.options.get_unsigned_int_option("jobs");
+    jobs=std::max(1u, std::min(jobs, 1u<<depth));
+
+    // symbolic execution happens in the workers
+    collect_goals();
+
+    worker_cover_goalst cover_goals(solver);
+    decision_proceduret::resultt result=
+      solve_cubes(depth, jobs, cover_goals);
+
+    return report_result(result, cover_goals, sat_start);
+  }
+
+  unsigned jobs=1;
+  if(bmc.options.get_option("jobs")!="")
+    jobs=bmc.options.get_unsigned_int_option("jobs");
+
+  if(jobs>1)
+  {
+    collect_goals();
+
+    worker_cover_goalst cover_goals(solver);
+    decision_proceduret::resultt result=solve_parallel(jobs, cover_goals);
+
+    return report_result(result, cover_goals, sat_start);
+  }
+
+  bmc.do_conversion();
+
+  collect_goals();
 
   do_before_solving();
 
@@ -113,10 +154,18 @@ safety_checkert::resultt bmc_all_propertiest::operator()()
 
   status() << "Running " << solver.decision_procedure_text() << eom;
 
-  bool error=false;
-
   decision_proceduret::resultt result=cover_goals();
 
+  return report_result(result, cover_goals, sat_start);
+}
+
+safety_checkert::resultt bmc_all_propertiest::report_result(
+  decision_proceduret::resultt result,
+  const cover_goalst &cover_goals,
+  absolute_timet sat_start)
+{
+  bool error=false;
+
   if(result==decision_proceduret::resultt::D_ERROR)
   {
     error=true;
@@ -12,10 +12,35 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_ALL_PROPERTIES_CLASS_H
 #define CPROVER_CBMC_ALL_PROPERTIES_CLASS_H
 
+#include <util/time_stopping.h>
+
 #include <solvers/prop/cover_goals.h>
 
 #include "bmc.h"
 
+/// The statistics of the goals that are solved by worker processes,
+/// which are not passed to a solver by this instance.
+class worker_cover_goalst:public cover_goalst
+{
+public:
+  explicit worker_cover_goalst(prop_convt &_prop_conv):
+    cover_goalst(_prop_conv)
+  {
+  }
+
+  void add_worker(
+    std::size_t number_of_goals,
+    std::size_t number_covered,
+    unsigned iterations)
+  {
+    for(std::size_t i=0; i<number_of_goals; i++)
+      add(const_literal(false));
+
+    _number_covered+=number_covered;
+    _iterations+=iterations;
+  }
+};
+
 class bmc_all_propertiest:
   public cover_goalst::observert,
   public messaget
@@ -91,6 +116,32 @@ protected:
 
   virtual void report(const cover_goalst &cover_goals);
   virtual void do_before_solving() {}
+
+  void collect_goals();
+
+  safety_checkert::resultt report_result(
+    decision_proceduret::resultt result,
+    const cover_goalst &cover_goals,
+    absolute_timet sat_start);
+
+  // solve the goals in worker processes, see --jobs
+  decision_proceduret::resultt solve_parallel(
+    unsigned jobs,
+    worker_cover_goalst &cover_goals);
+
+  void run_worker(
+    const std::vector<irep_idt> &properties,
+    std::ostream &out);
+
+  // execute and solve cubes in worker processes, see --split-branches
+  decision_proceduret::resultt solve_cubes(
+    unsigned depth,
+    unsigned jobs,
+    worker_cover_goalst &cover_goals);
+
+  void run_cube_worker(
+    const std::vector<bool> &cube,
+    std::ostream &out);
 };
 
 #endif // CPROVER_CBMC_ALL_PROPERTIES_CLASS_H
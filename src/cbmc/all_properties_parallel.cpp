@@ -0,0 +1,602 @@
+/*******************************************************************\
+
+Module: Checking All Properties in Worker Processes
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Checking All Properties in Worker Processes
+
+#include "all_properties_class.h"
+
+#include <algorithm>
+#include <deque>
+#include <sstream>
+#include <unordered_map>
+
+#include <util/irep_serialization.h>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+typedef std::unordered_map<unsigned, goto_programt::const_targett>
+  location_mapt;
+
+static void write_goto_trace(
+  const goto_tracet &goto_trace,
+  irep_serializationt &serializer,
+  std::ostream &out)
+{
+  serializer.write_string_ref(out, goto_trace.mode);
+  write_gb_word(out, goto_trace.steps.size());
+
+  for(const auto &step : goto_trace.steps)
+  {
+    write_gb_word(out, step.step_nr);
+    write_gb_word(out, static_cast<std::size_t>(step.type));
+    write_gb_word(out, step.hidden);
+    write_gb_word(out, step.internal);
+    write_gb_word(out, static_cast<std::size_t>(step.assignment_type));
+    write_gb_word(out, step.pc->location_number);
+    write_gb_word(out, step.thread_nr);
+    write_gb_word(out, step.cond_value);
+    serializer.reference_convert(step.cond_expr, out);
+    write_gb_string(out, step.comment);
+    serializer.reference_convert(step.lhs_object, out);
+    serializer.reference_convert(step.full_lhs, out);
+    serializer.reference_convert(step.lhs_object_value, out);
+    serializer.reference_convert(step.full_lhs_value, out);
+    serializer.write_string_ref(out, step.format_string);
+    serializer.write_string_ref(out, step.io_id);
+    write_gb_word(out, step.io_args.size());
+    for(const auto &arg : step.io_args)
+      serializer.reference_convert(arg, out);
+    write_gb_word(out, step.formatted);
+    serializer.write_string_ref(out, step.identifier);
+  }
+}
+
+static void read_goto_trace(
+  std::istream &in,
+  irep_serializationt &serializer,
+  const location_mapt &location_map,
+  goto_tracet &goto_trace)
+{
+  goto_trace.mode=serializer.read_string_ref(in);
+  std::size_t number_of_steps=irep_serializationt::read_gb_word(in);
+
+  for(std::size_t i=0; i<number_of_steps; i++)
+  {
+    goto_trace.steps.push_back(goto_trace_stept());
+    goto_trace_stept &step=goto_trace.steps.back();
+
+    step.step_nr=irep_serializationt::read_gb_word(in);
+    step.type=static_cast<goto_trace_stept::typet>(
+      irep_serializationt::read_gb_word(in));
+    step.hidden=irep_serializationt::read_gb_word(in)!=0;
+    step.internal=irep_serializationt::read_gb_word(in)!=0;
+    step.assignment_type=
+      static_cast<goto_trace_stept::assignment_typet>(
+        irep_serializationt::read_gb_word(in));
+
+    location_mapt::const_iterator l_it=
+      location_map.find(irep_serializationt::read_gb_word(in));
+    if(l_it==location_map.end())
+      throw "worker trace refers to unknown location";
+    step.pc=l_it->second;
+
+    step.thread_nr=irep_serializationt::read_gb_word(in);
+    step.cond_value=irep_serializationt::read_gb_word(in)!=0;
+    serializer.reference_convert(in, step.cond_expr);
+    step.comment=id2string(serializer.read_gb_string(in));
+    serializer.reference_convert(in, step.lhs_object);
+    serializer.reference_convert(in, step.full_lhs);
+    serializer.reference_convert(in, step.lhs_object_value);
+    serializer.reference_convert(in, step.full_lhs_value);
+    step.format_string=serializer.read_string_ref(in);
+    step.io_id=serializer.read_string_ref(in);
+    std::size_t number_of_args=irep_serializationt::read_gb_word(in);
+    for(std::size_t a=0; a<number_of_args; a++)
+    {
+      step.io_args.push_back(exprt());
+      serializer.reference_convert(in, step.io_args.back());
+    }
+    step.formatted=irep_serializationt::read_gb_word(in)!=0;
+    step.identifier=serializer.read_string_ref(in);
+  }
+}
+
+namespace
+{
+struct worker_resultt
+{
+  decision_proceduret::resultt result;
+  std::size_t number_covered;
+  unsigned iterations;
+  std::size_t number_of_goals;
+};
+}
+
+/// Reads the results written by run_worker and merges the status of
+/// the goals into the given map: a goal fails if it fails in any
+/// worker, and the trace of the first failure is kept.
+/// \return true on error
+static bool read_worker_result(
+  std::istream &in,
+  const location_mapt &location_map,
+  bmc_all_propertiest::goal_mapt &goal_map,
+  worker_resultt &worker_result)
+{
+  typedef bmc_all_propertiest::goalt goalt;
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serializer(ireps_container);
+
+  worker_result.result=
+    static_cast<decision_proceduret::resultt>(
+      irep_serializationt::read_gb_word(in));
+  worker_result.number_covered=irep_serializationt::read_gb_word(in);
+  worker_result.iterations=irep_serializationt::read_gb_word(in);
+  worker_result.number_of_goals=irep_serializationt::read_gb_word(in);
+
+  for(std::size_t i=0; i<worker_result.number_of_goals && in; i++)
+  {
+    goalt &goal=goal_map[serializer.read_string_ref(in)];
+
+    std::string description=id2string(serializer.read_gb_string(in));
+    if(goal.description.empty())
+      goal.description=description;
+
+    goalt::statust status=
+      static_cast<goalt::statust>(irep_serializationt::read_gb_word(in));
+
+    if(status==goalt::statust::FAILURE)
+    {
+      goto_tracet goto_trace;
+      read_goto_trace(in, serializer, location_map, goto_trace);
+
+      if(goal.status!=goalt::statust::FAILURE)
+      {
+        goal.status=status;
+        goal.goto_trace.steps.swap(goto_trace.steps);
+        goal.goto_trace.mode=goto_trace.mode;
+      }
+    }
+    else if(goal.status!=goalt::statust::FAILURE &&
+            (status==goalt::statust::ERROR ||
+             goal.status==goalt::statust::UNKNOWN))
+      goal.status=status;
+  }
+
+  return !in;
+}
+
+/// Checks the given properties, and writes their status, the traces of
+/// the failed ones and the statistics to the given stream. This runs in
+/// a worker process, i.e., it may modify the state of this instance and
+/// of the solver.
+void bmc_all_propertiest::run_worker(
+  const std::vector<irep_idt> &properties,
+  std::ostream &out)
+{
+  // the output of the workers would be interleaved
+  null_message_handlert null_message_handler;
+  set_message_handler(null_message_handler);
+  bmc.set_message_handler(null_message_handler);
+  bmc.symex.set_message_handler(null_message_handler);
+  solver.set_message_handler(null_message_handler);
+
+  goal_mapt all_goals;
+  all_goals.swap(goal_map);
+
+  for(const auto &id : properties)
+    goal_map.insert(*all_goals.find(id));
+
+  bmc.do_conversion();
+
+  do_before_solving();
+
+  cover_goalst cover_goals(solver);
+
+  cover_goals.set_message_handler(null_message_handler);
+  cover_goals.register_observer(*this);
+
+  for(const auto &g : goal_map)
+    cover_goals.add(!solver.convert(g.second.as_expr()));
+
+  decision_proceduret::resultt result=cover_goals();
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serializer(ireps_container);
+
+  write_gb_word(out, static_cast<std::size_t>(result));
+  write_gb_word(out, cover_goals.number_covered());
+  write_gb_word(out, cover_goals.iterations());
+  write_gb_word(out, goal_map.size());
+
+  for(const auto &g : goal_map)
+  {
+    serializer.write_string_ref(out, g.first);
+    write_gb_string(out, g.second.description);
+    write_gb_word(out, g.second.status);
+
+    if(g.second.status==goalt::statust::FAILURE)
+      write_goto_trace(g.second.goto_trace, serializer, out);
+  }
+}
+
+#ifndef _WIN32
+/// writes all of the given data to a file descriptor
+/// \return true on error
+static bool write_fd(int fd, const std::string &data)
+{
+  std::size_t written=0;
+
+  while(written<data.size())
+  {
+    ssize_t result=write(fd, data.data()+written, data.size()-written);
+
+    if(result==-1 && errno==EINTR)
+      continue;
+    if(result<=0)
+      return true;
+
+    written+=result;
+  }
+
+  return false;
+}
+
+/// reads from a file descriptor until the end of file
+/// \return true on error
+static bool read_fd(int fd, std::string &data)
+{
+  char buffer[4096];
+
+  while(true)
+  {
+    ssize_t result=read(fd, buffer, sizeof(buffer));
+
+    if(result==-1 && errno==EINTR)
+      continue;
+    if(result==-1)
+      return true;
+    if(result==0)
+      return false;
+
+    data.append(buffer, result);
+  }
+}
+#endif
+
+/// Distributes the goals over the given number of worker processes.
+/// Each worker is forked after symbolic execution, and hence shares the
+/// equation with this process copy-on-write, and converts it into its
+/// own copy of the solver. The workers pass the status of their goals
+/// and the traces of the failed ones back through a pipe. Threads would
+/// convert expressions that share irept nodes with each other, and the
+/// reference counts of these nodes are not atomic.
+decision_proceduret::resultt bmc_all_propertiest::solve_parallel(
+  unsigned jobs,
+  worker_cover_goalst &cover_goals)
+{
+#ifdef _WIN32
+  error() << "--jobs is not supported on this platform" << eom;
+  return decision_proceduret::resultt::D_ERROR;
+#else
+  // balance the number of instances of the goals over the workers,
+  // starting with the largest goals
+  std::vector<goal_mapt::const_iterator> goals;
+  goals.reserve(goal_map.size());
+  for(goal_mapt::const_iterator it=goal_map.begin();
+      it!=goal_map.end();
+      it++)
+    goals.push_back(it);
+
+  std::stable_sort(
+    goals.begin(),
+    goals.end(),
+    [](goal_mapt::const_iterator a, goal_mapt::const_iterator b)
+    {
+      return a->second.instances.size()>b->second.instances.size();
+    });
+
+  std::vector<std::vector<irep_idt>> partitions(jobs);
+  std::vector<std::size_t> load(jobs, 0);
+
+  for(const auto &g : goals)
+  {
+    std::size_t min=std::distance(
+      load.begin(), std::min_element(load.begin(), load.end()));
+    partitions[min].push_back(g->first);
+    load[min]+=g->second.instances.size()+1;
+  }
+
+  struct workert
+  {
+    pid_t pid;
+    int fd;
+  };
+
+  std::vector<workert> workers;
+  bool failed=false;
+
+  for(const auto &partition : partitions)
+  {
+    if(partition.empty())
+      continue;
+
+    int fd[2];
+    if(pipe(fd)==-1)
+    {
+      failed=true;
+      break;
+    }
+
+    pid_t pid=fork();
+
+    if(pid==0)
+    {
+      // child
+      close(fd[0]);
+
+      std::ostringstream out;
+      run_worker(partition, out);
+
+      bool write_error=write_fd(fd[1], out.str());
+      close(fd[1]);
+
+      _exit(write_error?1:0);
+    }
+
+    close(fd[1]);
+
+    if(pid==-1)
+    {
+      close(fd[0]);
+      failed=true;
+      break;
+    }
+
+    workers.push_back({pid, fd[0]});
+  }
+
+  status() << "Running " << solver.decision_procedure_text()
+           << " in " << workers.size() << " worker processes" << eom;
+
+  location_mapt location_map;
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      location_map[i_it->location_number]=i_it;
+
+  for(const auto &worker : workers)
+  {
+    std::string data;
+    bool read_error=read_fd(worker.fd, data);
+    close(worker.fd);
+
+    int exit_status;
+    if(waitpid(worker.pid, &exit_status, 0)==-1 ||
+       !WIFEXITED(exit_status) ||
+       WEXITSTATUS(exit_status)!=0 ||
+       read_error)
+    {
+      error() << "worker process failed" << eom;
+      failed=true;
+      continue;
+    }
+
+    std::istringstream in(data);
+    worker_resultt worker_result;
+
+    if(read_worker_result(in, location_map, goal_map, worker_result))
+    {
+      error() << "failed to read the results of a worker process" << eom;
+      failed=true;
+      continue;
+    }
+
+    if(worker_result.result==decision_proceduret::resultt::D_ERROR)
+      failed=true;
+
+    cover_goals.add_worker(
+      worker_result.number_of_goals,
+      worker_result.number_covered,
+      worker_result.iterations);
+  }
+
+  return failed?
+    decision_proceduret::resultt::D_ERROR:
+    decision_proceduret::resultt::D_UNSATISFIABLE;
+#endif
+}
+
+/// Executes the program symbolically along the given cube and checks
+/// all properties. This runs in a worker process. The output is empty if
+/// the cube is redundant, i.e., if symbolic execution did not reach the
+/// branches that the cube differs from cube 0 on.
+void bmc_all_propertiest::run_cube_worker(
+  const std::vector<bool> &cube,
+  std::ostream &out)
+{
+  null_message_handlert null_message_handler;
+  bmc.set_message_handler(null_message_handler);
+  bmc.symex.set_message_handler(null_message_handler);
+
+  bmc.symex.set_cube(cube);
+  bmc.symex(goto_functions);
+
+  for(std::size_t i=bmc.symex.get_cube_decisions(); i<cube.size(); i++)
+    if(cube[i])
+      return;
+
+  if(bmc.equation.has_threads())
+    (*bmc.memory_model)(bmc.equation);
+
+  bmc.slice();
+
+  collect_goals();
+
+  std::vector<irep_idt> properties;
+  properties.reserve(goal_map.size());
+  for(const auto &g : goal_map)
+    properties.push_back(g.first);
+
+  run_worker(properties, out);
+}
+
+/// Splits symbolic execution at the first depth branches into 2^depth
+/// cubes, each of which follows one direction at each of these branches.
+/// The cubes are executed symbolically and solved in up to jobs worker
+/// processes at a time. A property fails if it fails in any cube.
+decision_proceduret::resultt bmc_all_propertiest::solve_cubes(
+  unsigned depth,
+  unsigned jobs,
+  worker_cover_goalst &cover_goals)
+{
+#ifdef _WIN32
+  error() << "--split-branches is not supported on this platform" << eom;
+  return decision_proceduret::resultt::D_ERROR;
+#else
+  const std::size_t number_of_cubes=std::size_t(1)<<depth;
+
+  status() << "Splitting into " << number_of_cubes << " cubes, running "
+           << solver.decision_procedure_text() << " in up to "
+           << jobs << " worker processes" << eom;
+
+  location_mapt location_map;
+  forall_goto_functions(f_it, goto_functions)
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      location_map[i_it->location_number]=i_it;
+
+  struct workert
+  {
+    pid_t pid;
+    int fd;
+  };
+
+  std::deque<workert> workers;
+  std::size_t next_cube=0, redundant_cubes=0;
+  unsigned iterations=0;
+  bool failed=false;
+
+  while(next_cube<number_of_cubes || !workers.empty())
+  {
+    // keep up to jobs workers busy
+    while(!failed && workers.size()<jobs && next_cube<number_of_cubes)
+    {
+      std::vector<bool> cube(depth);
+      for(unsigned i=0; i<depth; i++)
+        cube[i]=((next_cube>>i)&1)!=0;
+
+      next_cube++;
+
+      int fd[2];
+      if(pipe(fd)==-1)
+      {
+        failed=true;
+        break;
+      }
+
+      pid_t pid=fork();
+
+      if(pid==0)
+      {
+        // child
+        close(fd[0]);
+
+        std::ostringstream out;
+
+        try
+        {
+          run_cube_worker(cube, out);
+        }
+
+        catch(...)
+        {
+          _exit(1);
+        }
+
+        bool write_error=write_fd(fd[1], out.str());
+        close(fd[1]);
+
+        _exit(write_error?1:0);
+      }
+
+      close(fd[1]);
+
+      if(pid==-1)
+      {
+        close(fd[0]);
+        failed=true;
+        break;
+      }
+
+      workers.push_back({pid, fd[0]});
+    }
+
+    if(workers.empty())
+      break;
+
+    workert worker=workers.front();
+    workers.pop_front();
+
+    std::string data;
+    bool read_error=read_fd(worker.fd, data);
+    close(worker.fd);
+
+    int exit_status;
+    if(waitpid(worker.pid, &exit_status, 0)==-1 ||
+       !WIFEXITED(exit_status) ||
+       WEXITSTATUS(exit_status)!=0 ||
+       read_error)
+    {
+      error() << "worker process failed" << eom;
+      failed=true;
+      continue;
+    }
+
+    if(data.empty())
+    {
+      redundant_cubes++;
+      continue;
+    }
+
+    std::istringstream in(data);
+    worker_resultt worker_result;
+
+    if(read_worker_result(in, location_map, goal_map, worker_result))
+    {
+      error() << "failed to read the results of a worker process" << eom;
+      failed=true;
+      continue;
+    }
+
+    if(worker_result.result==decision_proceduret::resultt::D_ERROR)
+      failed=true;
+
+    iterations+=worker_result.iterations;
+  }
+
+  statistics() << redundant_cubes << " of " << number_of_cubes
+               << " cubes were redundant" << eom;
+
+  // each goal counts once, however many cubes it was checked in
+  std::size_t number_covered=0;
+  for(const auto &g : goal_map)
+    if(g.second.status==goalt::statust::FAILURE)
+      number_covered++;
+
+  cover_goals.add_worker(goal_map.size(), number_covered, iterations);
+
+  return failed?
+    decision_proceduret::resultt::D_ERROR:
+    decision_proceduret::resultt::D_UNSATISFIABLE;
+#endif
+}
@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/message.h>
 #include <util/json.h>
 #include <util/cprover_prefix.h>
+#include <util/simplify_expr_cache.h>
 
 #include <langapi/mode.h>
 #include <langapi/language_util.h>
@@ -132,7 +133,10 @@ void bmct::do_conversion()
   status() << "converting SSA" << eom;
 
   // convert SSA
+  absolute_timet convert_start=current_time();
   equation.convert(prop_conv);
+  statistics() << "Runtime Convert SSA: "
+               << (current_time()-convert_start) << "s" << eom;
 
   // the 'extra constraints'
   if(!bmc_constraints.empty())
@@ -359,8 +363,18 @@ safety_checkert::resultt bmct::execute(const goto_functionst &goto_functions)
 {
   try
   {
+    if(options.get_bool_option("incremental"))
+      return incremental(goto_functions);
+
+    // the cubes are executed symbolically in worker processes
+    if(options.get_option("split-branches")!="")
+      return all_properties(goto_functions, prop_conv);
+
     // perform symbolic execution
+    absolute_timet symex_start=current_time();
     symex(goto_functions);
+    statistics() << "Runtime Symex: "
+                 << (current_time()-symex_start) << "s" << eom;
 
     // add a partial ordering, if required
     if(equation.has_threads())
@@ -373,8 +387,24 @@ safety_checkert::resultt bmct::execute(const goto_functionst &goto_functions)
                << equation.SSA_steps.size()
                << " steps" << eom;
 
+    if(simplify_expr_cache.enabled())
+    {
+      statistics() << "simplifier cache: "
+                   << simplify_expr_cache.get_hits() << " hits, "
+                   << simplify_expr_cache.get_misses() << " misses, "
+                   << simplify_expr_cache.get_evictions() << " evictions, "
+                   << simplify_expr_cache.get_flushes() << " flushes"
+                   << eom;
+    }
+
     slice();
 
+    // the nodes of the symex state and of the sliced steps are gone
+    std::size_t released=irept::release_unused_memory();
+    if(released!=0)
+      statistics() << "released " << released
+                   << " bytes of irep nodes" << eom;
+
     // coverage report
     std::string cov_out=options.get_option("symex-coverage-report");
     if(!cov_out.empty() &&
@@ -104,6 +104,8 @@ protected:
   virtual resultt stop_on_fail(
     const goto_functionst &goto_functions,
     prop_convt &solver);
+  virtual resultt incremental(
+    const goto_functionst &goto_functions);
   virtual void show_program();
   virtual void report_success();
   virtual void report_failure();
@@ -0,0 +1,217 @@
+/*******************************************************************\
+
+Module: Incremental Bounded Model Checking for ANSI-C
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Incremental Bounded Model Checking for ANSI-C
+
+#include "bmc.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <util/std_expr.h>
+#include <util/time_stopping.h>
+
+#include <solvers/prop/literal_expr.h>
+
+/// solves under the given assumptions, plus the assumption that one of
+/// the given literals is true
+static decision_proceduret::resultt solve_any(
+  prop_convt &prop_conv,
+  bvt assumptions,
+  const bvt &literals)
+{
+  if(literals.empty())
+    return decision_proceduret::resultt::D_UNSATISFIABLE;
+
+  or_exprt::operandst disjuncts;
+  disjuncts.reserve(literals.size());
+
+  for(const auto &l : literals)
+    disjuncts.push_back(literal_exprt(l));
+
+  assumptions.push_back(prop_conv.convert(disjunction(disjuncts)));
+  prop_conv.set_assumptions(assumptions);
+
+  return prop_conv.dec_solve();
+}
+
+/// Checks the program for increasing unwinding bounds. Symbolic execution
+/// stops at the current bound of the selected loops, and the paths cut off
+/// there are continued when the bound is increased. Only the SSA steps that
+/// are added for the new bound are passed to the solver, which is kept
+/// across all bounds. The cut-off for each bound is enabled by an
+/// assumption, and hence is switched off when checking larger bounds.
+safety_checkert::resultt bmct::incremental(
+  const goto_functionst &goto_functions)
+{
+  unsigned bound=1;
+  if(options.get_option("unwind-min")!="")
+    bound=std::max(1u, options.get_unsigned_int_option("unwind-min"));
+
+  unsigned max_bound=std::numeric_limits<unsigned>::max();
+  if(options.get_option("unwind-max")!="")
+    max_bound=options.get_unsigned_int_option("unwind-max");
+
+  if(max_bound<bound)
+  {
+    error() << "--unwind-max must not be smaller than --unwind-min" << eom;
+    return resultt::ERROR;
+  }
+
+  prop_conv.set_message_handler(get_message_handler());
+
+  if(!prop_conv.has_set_assumptions())
+  {
+    error() << "incremental unwinding requires a solver "
+            << "that supports assumptions" << eom;
+    return resultt::ERROR;
+  }
+
+  const bool unwinding_assertions=
+    options.get_bool_option("unwinding-assertions");
+
+  symex.set_incremental(options.get_option("incremental-check"), bound);
+
+  // perform symbolic execution up to the first bound
+  symex(goto_functions);
+
+  if(equation.has_threads())
+  {
+    error() << "incremental unwinding does not support threads" << eom;
+    return resultt::ERROR;
+  }
+
+  // the conjunction of all assumptions passed to the solver
+  literalt assumption=const_literal(true);
+
+  // true iff any property (but the unwinding assertions) fails
+  literalt property=const_literal(false);
+
+  // switch off the cut-offs of the previous bounds
+  bvt previous_cuts;
+
+  // the last step passed to the solver
+  auto last_converted=equation.SSA_steps.end();
+
+  while(true)
+  {
+    statistics() << "size of program expression: "
+                 << equation.SSA_steps.size()
+                 << " steps" << eom;
+
+    status() << "Unwinding bound " << bound << eom;
+
+    absolute_timet sat_start=current_time();
+
+    auto first=
+      last_converted==equation.SSA_steps.end()?
+      equation.SSA_steps.begin():std::next(last_converted);
+
+    equation.convert_incremental(prop_conv, first, assumption);
+
+    or_exprt::operandst new_violations;
+    bvt unwinding_violations;
+
+    for(auto it=first; it!=equation.SSA_steps.end(); ++it)
+    {
+      if(!it->is_assert())
+        continue;
+
+      // unwinding assertions are generated at the backwards goto
+      if(it->source.pc->is_backwards_goto())
+        unwinding_violations.push_back(!it->cond_literal);
+      else
+        new_violations.push_back(literal_exprt(!it->cond_literal));
+    }
+
+    if(!equation.SSA_steps.empty())
+      last_converted=std::prev(equation.SSA_steps.end());
+
+    if(!new_violations.empty())
+    {
+      new_violations.push_back(literal_exprt(property));
+      property=prop_conv.convert(disjunction(new_violations));
+    }
+
+    bvt assumptions=previous_cuts;
+    literalt cut=prop_conv.convert(symex_bmct::unwind_cut_symbol(bound));
+    assumptions.push_back(cut);
+    previous_cuts.push_back(!cut);
+
+    // the array and pointer constraints need to cover the new steps
+    prop_conv_solvert *prop_conv_solver=
+      dynamic_cast<prop_conv_solvert *>(&prop_conv);
+    if(prop_conv_solver!=nullptr)
+      prop_conv_solver->clear_post_processing();
+
+    status() << "Running " << prop_conv.decision_procedure_text() << eom;
+
+    decision_proceduret::resultt dec_result=
+      solve_any(prop_conv, assumptions, {property});
+
+    {
+      absolute_timet sat_stop=current_time();
+      status() << "Runtime decision procedure: "
+               << (sat_stop-sat_start) << "s" << eom;
+    }
+
+    if(dec_result==decision_proceduret::resultt::D_ERROR)
+    {
+      error() << "decision procedure failed" << eom;
+      return resultt::ERROR;
+    }
+
+    bool fail=dec_result==decision_proceduret::resultt::D_SATISFIABLE;
+    bool done=fail || !symex.has_cut_paths() ||
+      options.get_bool_option("stop-when-unsat");
+
+    if(!done && unwinding_assertions)
+    {
+      status() << "Checking unwinding assertions" << eom;
+
+      dec_result=solve_any(prop_conv, assumptions, unwinding_violations);
+
+      if(dec_result==decision_proceduret::resultt::D_ERROR)
+      {
+        error() << "decision procedure failed" << eom;
+        return resultt::ERROR;
+      }
+
+      // the loops cannot be unwound any further
+      if(dec_result==decision_proceduret::resultt::D_UNSATISFIABLE)
+        done=true;
+      else if(bound>=max_bound)
+        fail=true;
+    }
+
+    if(fail)
+    {
+      if(options.get_bool_option("trace"))
+      {
+        error_trace();
+        output_graphml(resultt::UNSAFE, goto_functions);
+      }
+
+      report_failure();
+      return resultt::UNSAFE;
+    }
+
+    if(done || bound>=max_bound)
+    {
+      report_success();
+      output_graphml(resultt::SAFE, goto_functions);
+      return resultt::SAFE;
+    }
+
+    // continue the paths cut off at this bound
+    ++bound;
+    symex.set_incremental_bound(bound);
+    symex.resume_unwinding(goto_functions, equation);
+  }
+}
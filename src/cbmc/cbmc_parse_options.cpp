@@ -23,6 +23,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/memory_info.h>
 #include <util/invariant.h>
 #include <util/exit_codes.h>
+#include <util/simplify_expr_cache.h>
 
 #include <ansi-c/c_preprocess.h>
 
@@ -145,6 +146,10 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("simplify", true);
 
+  if(cmdline.isset("simplify-cache-size"))
+    options.set_option(
+      "simplify-cache-size", cmdline.get_value("simplify-cache-size"));
+
   if(cmdline.isset("stop-on-fail") ||
      cmdline.isset("dimacs") ||
      cmdline.isset("outfile"))
@@ -165,6 +170,59 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
       cmdline.get_value("localize-faults-method"));
   }
 
+  if(cmdline.isset("jobs"))
+  {
+    if(cmdline.isset("localize-faults"))
+    {
+      error() << "--jobs does not support --localize-faults" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("jobs", cmdline.get_value("jobs"));
+  }
+
+  if(cmdline.isset("split-branches"))
+  {
+    unsigned depth=unsafe_string2unsigned(cmdline.get_value("split-branches"));
+    if(depth==0 || depth>16)
+    {
+      error() << "--split-branches expects a depth between 1 and 16" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    for(const char *option : {"stop-on-fail", "incremental", "cover",
+                              "localize-faults", "program-only", "show-vcc"})
+      if(cmdline.isset(option))
+      {
+        error() << "--split-branches does not support --" << option << eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+
+    options.set_option("split-branches", cmdline.get_value("split-branches"));
+  }
+
+  if(cmdline.isset("portfolio"))
+  {
+    if(unsafe_string2unsigned(cmdline.get_value("portfolio"))==0)
+    {
+      error() << "--portfolio expects a positive number of solvers" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("portfolio", cmdline.get_value("portfolio"));
+  }
+
+  if(cmdline.isset("ipasir"))
+  {
+    if(cmdline.isset("portfolio"))
+    {
+      error() << "--ipasir cannot be combined with --portfolio" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("ipasir", true);
+  }
+
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
@@ -180,6 +238,50 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("unwindset"))
     options.set_option("unwindset", cmdline.get_value("unwindset"));
 
+  // incremental unwinding
+  if(cmdline.isset("incremental") ||
+     cmdline.isset("incremental-check"))
+  {
+    options.set_option("incremental", true);
+
+    if(cmdline.isset("incremental-check"))
+      options.set_option(
+        "incremental-check", cmdline.get_value("incremental-check"));
+
+    if(cmdline.isset("unwind-min"))
+      options.set_option("unwind-min", cmdline.get_value("unwind-min"));
+
+    if(cmdline.isset("unwind-max"))
+      options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+
+    options.set_option("stop-when-unsat", cmdline.isset("stop-when-unsat"));
+
+    if(cmdline.isset("cover") ||
+       cmdline.isset("localize-faults") ||
+       cmdline.isset("beautify") ||
+       cmdline.isset("dimacs") ||
+       cmdline.isset("outfile") ||
+       cmdline.isset("refine") ||
+       cmdline.isset("refine-strings") ||
+       cmdline.isset("smt1") ||
+       cmdline.isset("smt2") ||
+       cmdline.isset("fpa") ||
+       cmdline.isset("cvc3") ||
+       cmdline.isset("cvc4") ||
+       cmdline.isset("boolector") ||
+       cmdline.isset("yices") ||
+       cmdline.isset("z3") ||
+       cmdline.isset("opensmt") ||
+       cmdline.isset("mathsat") ||
+       cmdline.isset("show-vcc") ||
+       cmdline.isset("program-only"))
+    {
+      error() << "--incremental only supports checking properties "
+              << "with the default SAT solver" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+  }
+
   // constant propagation
   if(cmdline.isset("no-propagation"))
     options.set_option("propagation", false);
@@ -246,6 +348,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   else
     options.set_option("arrays-uf", "auto");
 
+  if(cmdline.isset("lazy-array-constraints"))
+    options.set_option("lazy-array-constraints", true);
+
   if(cmdline.isset("dimacs"))
     options.set_option("dimacs", true);
 
@@ -286,6 +391,26 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("aig"))
     options.set_option("aig", true);
 
+  if(cmdline.isset("multiplier"))
+  {
+    const std::string multiplier=cmdline.get_value("multiplier");
+
+    if(multiplier!="shift-add" &&
+       multiplier!="wallace" &&
+       multiplier!="dadda")
+    {
+      error() << "unknown multiplier `" << multiplier << "'" << eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    options.set_option("multiplier", multiplier);
+  }
+
+  options.set_option(
+    "csd-multiplication", cmdline.isset("csd-multiplication"));
+  options.set_option(
+    "share-arithmetic", cmdline.isset("share-arithmetic"));
+
   // SMT Options
   bool version_set=false;
 
@@ -307,6 +432,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("fpa"))
     options.set_option("fpa", true);
 
+  if(cmdline.isset("smt2-pipe"))
+    options.set_option("smt2-pipe", true);
+
 
   bool solver_set=false;
 
@@ -540,6 +668,12 @@ int cbmc_parse_optionst::doit()
   if(set_properties())
     return CPROVER_EXIT_SET_PROPERTIES_FAILED;
 
+  // the goto program is final now, and only symbolic execution adds
+  // symbols from here on
+  if(options.get_option("simplify-cache-size")!="")
+    simplify_expr_cache.set_max_size(
+      options.get_unsigned_int_option("simplify-cache-size"));
+
   // get solver
   cbmc_solverst cbmc_solvers(
     options,
@@ -892,6 +1026,19 @@ int cbmc_parse_optionst::do_bmc(bmct &bmc)
   memory_info(debug());
   debug() << eom;
 
+  if(cmdline.isset("show-irep-stats"))
+  {
+    const irept::statisticst irep_statistics=irept::get_statistics();
+
+    status() << "irep nodes: "
+             << irep_statistics.nodes_alive << " alive, "
+             << irep_statistics.peak_nodes_alive << " at peak, "
+             << irep_statistics.nodes_allocated << " allocated" << eom;
+    status() << "irep node pool: "
+             << irep_statistics.chunks << " chunks, "
+             << irep_statistics.chunk_bytes << " bytes" << eom;
+  }
+
   return result;
 }
 
@@ -923,6 +1070,10 @@ void cbmc_parse_optionst::help()
     " --property id                only check one specific property\n"
     " --stop-on-fail               stop analysis once a failed property is detected\n" // NOLINT(*)
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
+    " --jobs n                     check the properties in n worker processes\n" // NOLINT(*)
+    " --split-branches k           split symbolic execution at the first k branches\n" // NOLINT(*)
+    "                              into 2^k cubes checked in worker processes\n" // NOLINT(*)
+    "                              (one per core unless --jobs is given)\n" // NOLINT(*)
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -963,6 +1114,7 @@ void cbmc_parse_optionst::help()
     " --round-to-minus-inf         rounding towards minus infinity\n"
     " --round-to-zero              rounding towards zero\n"
     HELP_FUNCTIONS
+    HELP_GOTO_BINARY_LOADING
     "\n"
     "Program representations:\n"
     " --show-parse-tree            show parse tree\n"
@@ -989,17 +1141,35 @@ void cbmc_parse_optionst::help()
     " --unwind nr                  unwind nr times\n"
     " --unwindset L:B,...          unwind loop L with a bound of B\n"
     "                              (use --show-loops to get the loop IDs)\n"
+    " --incremental                unwind all loops incrementally, reusing\n"
+    "                              the solver for increasing bounds\n"
+    " --incremental-check L        unwind loop L incrementally\n"
+    " --unwind-min nr              start incremental unwinding at bound nr\n"
+    " --unwind-max nr              stop incremental unwinding at bound nr\n"
+    " --stop-when-unsat            stop incremental unwinding at the first\n"
+    "                              bound for which all properties hold\n"
     " --show-vcc                   show the verification conditions\n"
     " --slice-formula              remove assignments unrelated to property\n"
     " --unwinding-assertions       generate unwinding assertions\n"
     " --partial-loops              permit paths with partial loops\n"
     " --no-pretty-names            do not simplify identifiers\n"
+    " --simplify-cache-size n      remember the last n simplified expressions\n" // NOLINT(*)
+    " --show-irep-stats            show the number of irep nodes alive and at peak\n" // NOLINT(*)
     " --graphml-witness filename   write the witness in GraphML format to filename\n" // NOLINT(*)
     "\n"
     "Backend options:\n"
     " --object-bits n              number of bits used for object addresses\n"
     " --dimacs                     generate CNF in DIMACS format\n"
-    " --beautify                   beautify the counterexample (greedy heuristic)\n" // NOLINT(*)
+    " --aig                        hash and rewrite an and-inverter graph before generating CNF\n" // NOLINT(*)
+    " --portfolio n                race n differently configured SAT solvers in worker processes\n" // NOLINT(*)
+    " --ipasir                     use the incremental SAT solver linked via IPASIR\n" // NOLINT(*)
+    " --multiplier m               encode multiplication as shift-add (default),\n" // NOLINT(*)
+    "                              wallace or dadda tree\n"
+    " --csd-multiplication         multiply by constants in canonical signed digits\n" // NOLINT(*)
+    " --share-arithmetic           share the circuits of equal products, and of\n" // NOLINT(*)
+    "                              quotients by equal nonzero constants\n"
+    " --beautify                   beautify the counterexample (core-guided if\n" // NOLINT(*)
+    "                              the solver gives cores, greedy otherwise)\n"
     " --localize-faults            localize faults (experimental)\n"
     " --smt1                       use default SMT1 solver (obsolete)\n"
     " --smt2                       use default SMT2 solver (Z3)\n"
@@ -1008,6 +1178,7 @@ void cbmc_parse_optionst::help()
     " --cvc4                       use CVC4\n"
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
+    " --smt2-pipe                  keep the SMT2 solver running, talk to it through pipes\n" // NOLINT(*)
     " --refine                     use refinement procedure (experimental)\n"
     " --refine-strings             use string refinement (experimental)\n"
     " --string-non-empty           add constraint that strings are non empty (experimental)\n" // NOLINT(*)
@@ -1017,6 +1188,7 @@ void cbmc_parse_optionst::help()
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
     " --arrays-uf-always           always turn arrays into uninterpreted functions\n" // NOLINT(*)
+    " --lazy-array-constraints     add array constraints only when the model violates them\n" // NOLINT(*)
     "\n"
     "Other options:\n"
     " --version                    show version and exit\n"
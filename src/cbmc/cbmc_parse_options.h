@@ -16,6 +16,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/parse_options.h>
 #include <util/language.h>
 
+#include <goto-programs/read_goto_binary.h>
+
 #include <analyses/goto_check.h>
 
 #include "xml_interface.h"
@@ -27,7 +29,12 @@ class optionst;
 #define CBMC_OPTIONS \
   "(program-only)(preprocess)(slice-by-trace):" \
   OPT_FUNCTIONS \
+  OPT_GOTO_BINARY_LOADING \
   "(no-simplify)(unwind):(unwindset):(slice-formula)(full-slice)" \
+  "(incremental)(incremental-check):(unwind-min):(unwind-max)" \
+  "(stop-when-unsat)" \
+  "(jobs):(portfolio):(split-branches):(ipasir)" \
+  "(simplify-cache-size):(show-irep-stats)" \
   "(debug-level):(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(outfile):(test-preprocessor)" \
   "D:I:(c89)(c99)(c11)(cpp98)(cpp03)(cpp11)" \
@@ -38,6 +45,7 @@ class optionst;
   "(no-built-in-assertions)" \
   "(xml-ui)(xml-interface)(json-ui)" \
   "(smt1)(smt2)(fpa)(cvc3)(cvc4)(boolector)(yices)(z3)(opensmt)(mathsat)" \
+  "(smt2-pipe)" \
   "(no-sat-preprocessor)" \
   "(no-pretty-names)(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
@@ -46,6 +54,7 @@ class optionst;
   "(string-printable)" \
   "(string-max-length):" \
   "(string-max-input-length):" \
+  "(multiplier):(csd-multiplication)(share-arithmetic)" \
   "(aig)(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
   "(little-endian)(big-endian)" \
   "(show-goto-functions)(show-loops)" \
@@ -60,7 +69,7 @@ class optionst;
   "(mm):" \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)(gcc)" \
   "(ppc-macos)(unsigned-char)" \
-  "(arrays-uf-always)(arrays-uf-never)" \
+  "(arrays-uf-always)(arrays-uf-never)(lazy-array-constraints)" \
   "(string-abstraction)(no-arch)(arch):" \
   "(round-to-nearest)(round-to-plus-inf)(round-to-minus-inf)(round-to-zero)" \
   "(graphml-witness):" \
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/make_unique.h>
 
 #include <solvers/sat/satcheck.h>
+#include <solvers/sat/satcheck_ipasir.h>
 #include <solvers/refinement/bv_refinement.h>
 #include <solvers/refinement/string_refinement.h>
 #include <solvers/smt1/smt1_dec.h>
@@ -88,14 +89,76 @@ smt2_dect::solvert cbmc_solverst::get_smt2_solver_type() const
   return s;
 }
 
+bv_utilst::encodingt cbmc_solverst::get_arith_encoding() const
+{
+  bv_utilst::encodingt encoding;
+
+  const std::string multiplier=options.get_option("multiplier");
+
+  if(multiplier=="wallace")
+    encoding.multiplier=bv_utilst::multipliert::WALLACE;
+  else if(multiplier=="dadda")
+    encoding.multiplier=bv_utilst::multipliert::DADDA;
+
+  encoding.csd_constants=options.get_bool_option("csd-multiplication");
+  encoding.share=options.get_bool_option("share-arithmetic");
+
+  return encoding;
+}
+
 std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
 {
   auto solver=util_make_unique<solvert>();
 
-  if(options.get_bool_option("beautify") ||
+  if(options.get_option("portfolio")!="")
+  {
+#ifdef SATCHECK_MINISAT2
+    // the workers continue from the clauses of this process, hence
+    // there is no simplifier
+    auto portfolio=util_make_unique<satcheck_minisat_portfoliot>(
+      options.get_unsigned_int_option("portfolio"));
+
+    if(options.get_bool_option("aig"))
+      solver->set_prop(
+        util_make_unique<aig_prop_solvert>(std::move(portfolio)));
+    else
+      solver->set_prop(std::move(portfolio));
+#else
+    error() << "--portfolio requires MiniSat 2" << eom;
+    throw 0;
+#endif
+  }
+  else if(options.get_bool_option("ipasir"))
+  {
+#ifdef HAVE_IPASIR
+    // the solver keeps its learnt clauses across the calls with
+    // assumptions made by fault localization and beautification
+    if(options.get_bool_option("aig"))
+      solver->set_prop(
+        util_make_unique<aig_prop_solvert>(
+          util_make_unique<satcheck_ipasirt>()));
+    else
+      solver->set_prop(util_make_unique<satcheck_ipasirt>());
+#else
+    error() << "--ipasir requires an IPASIR solver" << eom;
+    throw 0;
+#endif
+  }
+  else if(options.get_bool_option("aig"))
+  {
+    // the graph is converted into CNF incrementally, which the
+    // simplifier does not permit
+    solver->set_prop(
+      util_make_unique<aig_prop_solvert>(
+        util_make_unique<satcheck_no_simplifiert>()));
+  }
+  else if(options.get_bool_option("beautify") ||
+     options.get_bool_option("incremental") ||
+     options.get_bool_option("lazy-array-constraints") ||
      !options.get_bool_option("sat-preprocessor")) // no simplifier
   {
-    // simplifier won't work with beautification
+    // simplifier won't work with beautification, incremental unwinding
+    // or constraints added after solving
     solver->set_prop(util_make_unique<satcheck_no_simplifiert>());
   }
   else // with simplifier
@@ -112,6 +175,11 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_default()
   else if(options.get_option("arrays-uf")=="always")
     bv_cbmc->unbounded_array=bv_cbmct::unbounded_arrayt::U_ALL;
 
+  bv_cbmc->array_lemmas_on_demand=
+    options.get_bool_option("lazy-array-constraints");
+
+  bv_cbmc->set_arith_encoding(get_arith_encoding());
+
   solver->set_prop_conv(std::move(bv_cbmc));
 
   return solver;
@@ -128,6 +196,7 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_dimacs()
   std::string filename=options.get_option("outfile");
 
   auto cbmc_dimacs=util_make_unique<cbmc_dimacst>(ns, *prop, filename);
+  cbmc_dimacs->set_arith_encoding(get_arith_encoding());
   return util_make_unique<solvert>(std::move(cbmc_dimacs), std::move(prop));
 }
 
@@ -286,6 +355,9 @@ std::unique_ptr<cbmc_solverst::solvert> cbmc_solverst::get_smt2(
     if(options.get_bool_option("fpa"))
       smt2_dec->use_FPA_theory=true;
 
+    smt2_dec->set_message_handler(get_message_handler());
+    smt2_dec->set_use_pipe(options.get_bool_option("smt2-pipe"));
+
     return util_make_unique<solvert>(std::move(smt2_dec));
   }
   else if(filename=="-")
@@ -143,6 +143,8 @@ protected:
   smt1_dect::solvert get_smt1_solver_type() const;
   smt2_dect::solvert get_smt2_solver_type() const;
 
+  bv_utilst::encodingt get_arith_encoding() const;
+
   // consistency checks during solver creation
   void no_beautification();
   void no_incremental_check();
@@ -15,6 +15,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/source_location.h>
 #include <util/simplify_expr.h>
+#include <util/std_expr.h>
+#include <util/string2int.h>
 
 symex_bmct::symex_bmct(
   message_handlert &mh,
@@ -25,10 +27,52 @@ symex_bmct::symex_bmct(
     record_coverage(false),
     max_unwind(0),
     max_unwind_is_set(false),
+    incremental(false),
+    incremental_bound(0),
+    l2_scanned(0),
+    cube_decisions(0),
     symex_coverage(_ns)
 {
 }
 
+/// follows the cube at the first forward branches
+void symex_bmct::symex_goto(statet &state)
+{
+  const goto_programt::instructiont &instruction=*state.source.pc;
+
+  if(cube_decisions<cube.size() &&
+     !instruction.is_backwards_goto() &&
+     instruction.targets.size()==1 &&
+     !state.guard.is_false() &&
+     state.threads.size()==1)
+  {
+    exprt guard=instruction.guard;
+    clean_expr(guard, state, false);
+    state.rename(guard, ns);
+    do_simplify(guard);
+
+    if(!guard.is_constant())
+    {
+      target.goto_instruction(state.guard.as_expr(), guard, state.source);
+
+      if(cube[cube_decisions++])
+      {
+        symex_assume(state, guard);
+        symex_transition(state, instruction.get_target());
+      }
+      else
+      {
+        symex_assume(state, not_exprt(guard));
+        symex_transition(state);
+      }
+
+      return;
+    }
+  }
+
+  goto_symext::symex_goto(state);
+}
+
 /// show progress
 void symex_bmct::symex_step(
   const goto_functionst &goto_functions,
@@ -119,7 +163,9 @@ bool symex_bmct::get_unwind(
     thread_loop_limits[source.thread_nr];
 
   loop_limitst::const_iterator l_it=this_thread_limits.find(id);
-  if(l_it!=this_thread_limits.end())
+  if(is_incremental_loop(id))
+    this_loop_limit=incremental_bound;
+  else if(l_it!=this_thread_limits.end())
     this_loop_limit=l_it->second;
   else
   {
@@ -144,6 +190,121 @@ bool symex_bmct::get_unwind(
   return abort;
 }
 
+/// Keeps a copy of the state for incrementally unwound loops, and makes
+/// the unwinding assumption or assertion conditional on the cut symbol
+/// of the current bound, which can later be switched off by the solver.
+void symex_bmct::loop_bound_exceeded(
+  statet &state,
+  const exprt &guard)
+{
+  if(!is_incremental_loop(goto_programt::loop_id(*state.source.pc)))
+  {
+    goto_symext::loop_bound_exceeded(state, guard);
+    return;
+  }
+
+  cut_paths.push_back(state);
+
+  state.guard.add(unwind_cut_symbol(incremental_bound));
+
+  goto_symext::loop_bound_exceeded(state, guard);
+}
+
+/// Continues all paths that were cut off at the previous bound, up to
+/// the current incremental_bound. The resulting SSA steps are appended
+/// to the equation.
+void symex_bmct::resume_unwinding(
+  const goto_functionst &goto_functions,
+  const symex_target_equationt &equation)
+{
+  std::list<statet> paths;
+  paths.swap(cut_paths);
+
+  for(auto &state : paths)
+  {
+    fresh_l2_names(state, equation);
+
+    // The pending merges have been done by the path that continued past
+    // the loop; doing them again would add the same paths twice.
+    for(auto &frame : state.call_stack())
+      frame.goto_state_map.clear();
+
+    // the backwards goto is executed again, with the increased bound
+    PRECONDITION(state.source.pc->is_backwards_goto());
+    unsigned &unwind=
+      state.top().loop_iterations[
+        goto_programt::loop_id(*state.source.pc)].count;
+    PRECONDITION(unwind>0);
+    unwind--;
+
+    while(!state.call_stack().empty())
+      symex_threaded_step(state, goto_functions);
+
+    state.dirty=nullptr;
+  }
+}
+
+/// Moves the L2 names of \p state past all those defined in \p equation,
+/// which includes the steps of the paths that continued after \p state
+/// was cut off. Each name gets a fresh L2 index that is defined to be
+/// equal to its current value.
+void symex_bmct::fresh_l2_names(
+  statet &state,
+  const symex_target_equationt &equation)
+{
+  auto it=equation.SSA_steps.begin();
+  std::advance(it, l2_scanned);
+
+  for(; it!=equation.SSA_steps.end(); ++it, ++l2_scanned)
+  {
+    if(!it->is_assignment() && !it->is_decl())
+      continue;
+
+    ssa_exprt l1=it->ssa_lhs;
+    unsigned count=unsafe_string2unsigned(id2string(l1.get_level_2()));
+    l1.remove_level_2();
+
+    auto entry=l2_counts.insert(
+      std::make_pair(l1.get_identifier(), std::make_pair(l1, count)));
+    if(!entry.second && entry.first->second.second<count)
+      entry.first->second.second=count;
+  }
+
+  for(const auto &entry : l2_counts)
+  {
+    const irep_idt &l1_identifier=entry.first;
+    unsigned current=state.level2.current_count(l1_identifier);
+    unsigned fresh=entry.second.second+1;
+
+    if(current>=fresh)
+      continue;
+
+    ssa_exprt rhs=entry.second.first;
+    rhs.set_level_2(current);
+
+    ssa_exprt lhs=entry.second.first;
+    lhs.set_level_2(fresh);
+
+    target.assignment(
+      true_exprt(),
+      lhs,
+      lhs,
+      lhs.get_original_expr(),
+      rhs,
+      state.source,
+      symex_targett::assignment_typet::HIDDEN);
+
+    state.level2.add(l1_identifier, entry.second.first);
+    state.level2.set_counter(l1_identifier, fresh);
+  }
+}
+
+symbol_exprt symex_bmct::unwind_cut_symbol(unsigned bound)
+{
+  return symbol_exprt(
+    "symex::unwind_cut::"+std::to_string(bound), bool_typet());
+}
+
 bool symex_bmct::get_unwind_recursion(
   const irep_idt &id,
   const unsigned thread_nr,
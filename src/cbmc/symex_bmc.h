@@ -12,9 +12,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_SYMEX_BMC_H
 #define CPROVER_CBMC_SYMEX_BMC_H
 
+#include <list>
+#include <vector>
+
 #include <util/message.h>
 
 #include <goto-symex/goto_symex.h>
+#include <goto-symex/symex_target_equation.h>
 
 #include "symex_coverage.h"
 
@@ -30,6 +34,11 @@ public:
   // To show progress
   source_locationt last_source_location;
 
+  void set_message_handler(message_handlert &mh)
+  {
+    log.set_message_handler(mh);
+  }
+
   // Control unwinding.
 
   void set_unwind_limit(unsigned limit)
@@ -53,6 +62,51 @@ public:
     loop_limits[id]=limit;
   }
 
+  // Incremental unwinding: the loops selected by incremental_loop
+  // (all loops if empty) are unwound up to incremental_bound only.
+  // Paths cut off at this bound are kept, and are continued by
+  // resume_unwinding once the bound has been increased.
+
+  void set_incremental(const irep_idt &loop_id, unsigned bound)
+  {
+    incremental=true;
+    incremental_loop=loop_id;
+    incremental_bound=bound;
+  }
+
+  void set_incremental_bound(unsigned bound)
+  {
+    incremental_bound=bound;
+  }
+
+  bool has_cut_paths() const
+  {
+    return !cut_paths.empty();
+  }
+
+  void resume_unwinding(
+    const goto_functionst &goto_functions,
+    const symex_target_equationt &equation);
+
+  // the cut-off at the given bound is in effect iff this is true
+  static symbol_exprt unwind_cut_symbol(unsigned bound);
+
+  // Splitting into cubes: the first cube.size() forward branches whose
+  // condition does not simplify to a constant only follow the
+  // direction given by cube, and assume the condition of that branch.
+
+  void set_cube(const std::vector<bool> &_cube)
+  {
+    cube=_cube;
+    cube_decisions=0;
+  }
+
+  // the number of branches that followed the cube
+  std::size_t get_cube_decisions() const
+  {
+    return cube_decisions;
+  }
+
   bool output_coverage_report(
     const goto_functionst &goto_functions,
     const std::string &path) const
@@ -78,6 +132,32 @@ protected:
   typedef std::map<unsigned, loop_limitst> thread_loop_limitst;
   thread_loop_limitst thread_loop_limits;
 
+  bool incremental;
+  irep_idt incremental_loop;
+  unsigned incremental_bound;
+
+  // states at the backwards goto of a loop that hit incremental_bound
+  std::list<statet> cut_paths;
+
+  // The largest L2 index of each L1 name assigned in the first
+  // l2_scanned steps of the equation. The paths that were not cut off
+  // have continued past the loop, and hence the L2 counters of the cut
+  // states are outdated when they are resumed.
+  typedef std::unordered_map<
+    irep_idt, std::pair<ssa_exprt, unsigned>, irep_id_hash> l2_countst;
+  l2_countst l2_counts;
+  std::size_t l2_scanned;
+
+  void fresh_l2_names(statet &state, const symex_target_equationt &equation);
+
+  std::vector<bool> cube;
+  std::size_t cube_decisions;
+
+  bool is_incremental_loop(const irep_idt &id) const
+  {
+    return incremental && (incremental_loop.empty() || incremental_loop==id);
+  }
+
   //
   // overloaded from goto_symext
   //
@@ -89,11 +169,15 @@ protected:
     const statet::goto_statet &goto_state,
     statet &state);
 
+  virtual void symex_goto(statet &state);
+
   // for loop unwinding
   virtual bool get_unwind(
     const symex_targett::sourcet &source,
     unsigned unwind);
 
+  virtual void loop_bound_exceeded(statet &state, const exprt &guard);
+
   virtual bool get_unwind_recursion(
     const irep_idt &identifier,
     const unsigned thread_nr,
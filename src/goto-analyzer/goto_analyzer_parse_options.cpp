@@ -264,6 +264,9 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("location-sensitive", true);
     }
 
+    if(cmdline.isset("call-graph-worklist"))
+      options.set_option("call-graph-worklist", true);
+
     // Domain choice
     if(cmdline.isset("constants"))
     {
@@ -471,10 +474,20 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
   if(options.get_bool_option("taint"))
   {
     std::string taint_file=cmdline.get_value("taint");
+    bool use_summaries=
+      cmdline.isset("taint-summaries") || cmdline.isset("taint-summary-cache");
+    std::string summary_cache_file=cmdline.get_value("taint-summary-cache");
 
     if(cmdline.isset("show-taint"))
     {
-      taint_analysis(goto_model, taint_file, get_message_handler(), true, "");
+      if(use_summaries)
+      {
+        error() << "--show-taint cannot be used with taint summaries" << eom;
+        return CPROVER_EXIT_USAGE_ERROR;
+      }
+
+      taint_analysis(
+        goto_model, taint_file, get_message_handler(), true, "", false, "");
       return CPROVER_EXIT_SUCCESS;
     }
     else
@@ -482,7 +495,13 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       std::string json_file=cmdline.get_value("json");
       bool result=
         taint_analysis(
-          goto_model, taint_file, get_message_handler(), false, json_file);
+          goto_model,
+          taint_file,
+          get_message_handler(),
+          false,
+          json_file,
+          use_summaries,
+          summary_cache_file);
       return result ? CPROVER_EXIT_VERIFICATION_UNSAFE : CPROVER_EXIT_SUCCESS;
     }
   }
@@ -620,6 +639,8 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    analyzer->set_call_graph_worklist(
+      options.get_bool_option("call-graph-worklist"));
 
     // Run
     status() << "Computing abstract states" << eom;
@@ -831,6 +852,8 @@ void goto_analyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --location-sensitive         use location-sensitive abstract interpreter\n"
     " --concurrent                 use concurrency-aware abstract interpreter\n"
+    " --call-graph-worklist        use one work queue for all functions,\n"
+    "                              ordered by the call graph\n"
     "\n"
     "Domain options:\n"
     " --constants                  constant domain\n"
@@ -848,6 +871,9 @@ void goto_analyzer_parse_optionst::help()
     "Specific analyses:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --taint file_name            perform taint analysis using rules in given file\n"
+    " --taint-summaries            analyse functions separately using summaries\n"
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --taint-summary-cache file   keep taint summaries across runs in given file\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -884,6 +910,7 @@ void goto_analyzer_parse_optionst::help()
     " --main-class class-name      set the name of the main class\n"
     JAVA_BYTECODE_LANGUAGE_OPTIONS_HELP
     HELP_FUNCTIONS
+    HELP_GOTO_BINARY_LOADING
     "\n"
     "Program representations:\n"
     " --show-parse-tree            show parse tree\n"
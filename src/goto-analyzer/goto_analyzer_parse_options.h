@@ -106,6 +106,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/language.h>
 
 #include <goto-programs/goto_model.h>
+#include <goto-programs/read_goto_binary.h>
 #include <goto-programs/show_goto_functions.h>
 
 #include <analyses/ai.h>
@@ -119,6 +120,7 @@ class optionst;
 
 #define GOTO_ANALYSER_OPTIONS \
   OPT_FUNCTIONS \
+  OPT_GOTO_BINARY_LOADING \
   "D:I:(std89)(std99)(std11)" \
   "(classpath):(cp):(main-class):" \
   "(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
@@ -130,7 +132,7 @@ class optionst;
   "(show-properties)(show-reachable-properties)(property):" \
   "(verbosity):(version)" \
   "(gcc)(arch):" \
-  "(taint):(show-taint)" \
+  "(taint):(show-taint)(taint-summaries)(taint-summary-cache):" \
   "(show-local-may-alias)" \
   "(json):(xml):" \
   "(text):(dot):" \
@@ -141,7 +143,7 @@ class optionst;
   "(constants)" \
   "(dependence-graph)" \
   "(show)(verify)(simplify):" \
-  "(location-sensitive)(concurrent)" \
+  "(location-sensitive)(concurrent)(call-graph-worklist)" \
   "(no-simplify-slicing)" \
   JAVA_BYTECODE_LANGUAGE_OPTIONS
 
@@ -22,9 +22,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/class_hierarchy.h>
 
+#include <analyses/call_graph.h>
 #include <analyses/custom_bitvector_analysis.h>
 
 #include "taint_parser.h"
+#include "taint_summary.h"
 
 class taint_analysist:public messaget
 {
@@ -38,7 +40,9 @@ public:
     const symbol_tablet &,
     goto_functionst &,
     bool show_full,
-    const std::string &json_file_name);
+    const std::string &json_file_name,
+    bool use_summaries,
+    const std::string &summary_cache_file_name);
 
 protected:
   taint_parse_treet taint;
@@ -46,6 +50,20 @@ protected:
 
   void instrument(const namespacet &, goto_functionst &);
   void instrument(const namespacet &, goto_functionst::goto_functiont &);
+
+  bool summary_analysis(
+    const namespacet &,
+    const goto_functionst &,
+    const std::string &summary_cache_file_name,
+    bool use_json,
+    json_arrayt &json_result);
+
+  void report(
+    const symbolt &function,
+    const source_locationt &,
+    bool &first,
+    bool use_json,
+    json_arrayt &json_result);
 };
 
 void taint_analysist::instrument(
@@ -223,12 +241,163 @@ void taint_analysist::instrument(
   }
 }
 
+/// Reports a failed assertion of a sink rule
+void taint_analysist::report(
+  const symbolt &function,
+  const source_locationt &source_location,
+  bool &first,
+  bool use_json,
+  json_arrayt &json_result)
+{
+  if(first)
+  {
+    first=false;
+    if(!use_json)
+      std::cout << "\n"
+                << "******** Function " << function.display_name() << '\n';
+  }
+
+  if(use_json)
+  {
+    json_objectt json;
+    json["bugClass"]=
+      json_stringt(id2string(source_location.get_property_class()));
+    json["file"]=
+      json_stringt(id2string(source_location.get_file()));
+    json["line"]=
+      json_numbert(id2string(source_location.get_line()));
+    json_result.array.push_back(json);
+  }
+  else
+  {
+    std::cout << source_location;
+    if(!source_location.get_comment().empty())
+      std::cout << ": " << source_location.get_comment();
+
+    if(!source_location.get_property_class().empty())
+      std::cout << " ("
+                << source_location.get_property_class() << ")";
+
+    std::cout << '\n';
+  }
+}
+
+/// Analyses the functions separately, callees before their callers, and
+/// reports the sinks reached from the entry point, or from any function
+/// if there is none
+/// \return true iff the summary cache could not be written
+bool taint_analysist::summary_analysis(
+  const namespacet &ns,
+  const goto_functionst &goto_functions,
+  const std::string &summary_cache_file_name,
+  bool use_json,
+  json_arrayt &json_result)
+{
+  std::set<std::string> taints;
+  for(const auto &rule : taint.rules)
+    taints.insert(id2string(rule.taint));
+
+  taint_summary_cachet cache;
+
+  if(!summary_cache_file_name.empty())
+  {
+    status() << "Reading taint summary cache `" << summary_cache_file_name
+             << "'" << eom;
+
+    // the summaries are then computed anew, and the cache is overwritten
+    if(cache.read(summary_cache_file_name))
+      warning() << "Ignoring taint summary cache `" << summary_cache_file_name
+                << "', which is corrupt or of another version" << eom;
+  }
+
+  status() << "Data-flow analysis with function summaries" << eom;
+
+  taint_summariest summaries;
+  taint_summaries(
+    goto_functions, ns, taints, cache, summaries, get_message_handler());
+
+  if(!summary_cache_file_name.empty() &&
+     cache.write(summary_cache_file_name))
+  {
+    error() << "Failed to write taint summary cache `"
+            << summary_cache_file_name << "'" << eom;
+    return true;
+  }
+
+  // the functions reachable from the roots
+  std::set<irep_idt> reachable;
+  std::vector<irep_idt> working;
+
+  if(goto_functions.function_map.find(goto_functionst::entry_point())!=
+     goto_functions.function_map.end())
+    working.push_back(goto_functionst::entry_point());
+  else
+    forall_goto_functions(f_it, goto_functions)
+      working.push_back(f_it->first);
+
+  const call_grapht call_graph(goto_functions);
+
+  while(!working.empty())
+  {
+    irep_idt function=working.back();
+    working.pop_back();
+
+    if(!reachable.insert(function).second)
+      continue;
+
+    for(auto c_it=call_graph.graph.lower_bound(function);
+        c_it!=call_graph.graph.upper_bound(function);
+        c_it++)
+      working.push_back(c_it->second);
+  }
+
+  // the sinks that fail however the function is called, by function
+  taint_summaryt::sinkst sinks;
+
+  for(const auto &function : reachable)
+  {
+    taint_summariest::const_iterator s_it=summaries.find(function);
+    if(s_it==summaries.end())
+      continue;
+
+    for(const auto &sink : s_it->second.sinks)
+      if(sink.object.empty())
+        sinks.insert(sink);
+  }
+
+  irep_idt last_function;
+  bool first=true;
+
+  for(const auto &sink : sinks)
+  {
+    if(sink.function=="__actual_thread_spawn")
+      continue;
+
+    if(sink.function!=last_function)
+    {
+      last_function=sink.function;
+      first=true;
+    }
+
+    report(
+      ns.lookup(sink.function),
+      sink.source_location,
+      first,
+      use_json,
+      json_result);
+  }
+
+  return false;
+}
+
 bool taint_analysist::operator()(
   const std::string &taint_file_name,
   const symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
   bool show_full,
-  const std::string &json_file_name)
+  const std::string &json_file_name,
+  bool use_summaries,
+  const std::string &summary_cache_file_name)
 {
   try
   {
@@ -258,119 +427,98 @@ bool taint_analysist::operator()(
     instrument(ns, goto_functions);
     goto_functions.update();
 
-    bool have_entry_point=
-      goto_functions.function_map.find(goto_functionst::entry_point())!=
-      goto_functions.function_map.end();
-
-    // do we have an entry point?
-    if(have_entry_point)
+    if(use_summaries)
     {
-      status() << "Working from entry point" << eom;
+      if(summary_analysis(
+           ns, goto_functions, summary_cache_file_name, use_json, json_result))
+        return true;
     }
     else
     {
-      status() << "No entry point found; "
-               << "we will consider the heads of all functions as reachable"
-               << eom;
-
-      goto_programt end, gotos, calls;
-
-      end.add_instruction(END_FUNCTION);
-
-      forall_goto_functions(f_it, goto_functions)
-        if(f_it->second.body_available() &&
-           f_it->first!=goto_functionst::entry_point())
-        {
-          goto_programt::targett t=calls.add_instruction();
-          code_function_callt call;
-          call.function()=ns.lookup(f_it->first).symbol_expr();
-          t->make_function_call(call);
-          calls.add_instruction()->make_goto(end.instructions.begin());
-          goto_programt::targett g=gotos.add_instruction();
-          g->make_goto(t, side_effect_expr_nondett(bool_typet()));
-        }
-
-      goto_functionst::goto_functiont &entry=
-        goto_functions.function_map[goto_functionst::entry_point()];
+      bool have_entry_point=
+        goto_functions.function_map.find(goto_functionst::entry_point())!=
+        goto_functions.function_map.end();
 
-      goto_programt &body=entry.body;
+      // do we have an entry point?
+      if(have_entry_point)
+      {
+        status() << "Working from entry point" << eom;
+      }
+      else
+      {
+        status() << "No entry point found; "
+                 << "we will consider the heads of all functions as reachable"
+                 << eom;
 
-      body.destructive_append(gotos);
-      body.destructive_append(calls);
-      body.destructive_append(end);
+        goto_programt end, gotos, calls;
 
-      goto_functions.update();
-    }
+        end.add_instruction(END_FUNCTION);
 
-    status() << "Data-flow analysis" << eom;
+        forall_goto_functions(f_it, goto_functions)
+          if(f_it->second.body_available() &&
+             f_it->first!=goto_functionst::entry_point())
+          {
+            goto_programt::targett t=calls.add_instruction();
+            code_function_callt call;
+            call.function()=ns.lookup(f_it->first).symbol_expr();
+            t->make_function_call(call);
+            calls.add_instruction()->make_goto(end.instructions.begin());
+            goto_programt::targett g=gotos.add_instruction();
+            g->make_goto(t, side_effect_expr_nondett(bool_typet()));
+          }
 
-    custom_bitvector_analysist custom_bitvector_analysis;
-    custom_bitvector_analysis(goto_functions, ns);
+        goto_functionst::goto_functiont &entry=
+          goto_functions.function_map[goto_functionst::entry_point()];
 
-    if(show_full)
-    {
-      custom_bitvector_analysis.output(ns, goto_functions, std::cout);
-      return false;
-    }
+        goto_programt &body=entry.body;
 
-    forall_goto_functions(f_it, goto_functions)
-    {
-      if(!f_it->second.body.has_assertion())
-        continue;
+        body.destructive_append(gotos);
+        body.destructive_append(calls);
+        body.destructive_append(end);
 
-      const symbolt &symbol=ns.lookup(f_it->first);
+        goto_functions.update();
+      }
 
-      if(f_it->first=="__actual_thread_spawn")
-        continue;
+      status() << "Data-flow analysis" << eom;
 
-      bool first=true;
+      custom_bitvector_analysist custom_bitvector_analysis;
+      custom_bitvector_analysis(goto_functions, ns);
 
-      forall_goto_program_instructions(i_it, f_it->second.body)
+      if(show_full)
       {
-        if(!i_it->is_assert())
-          continue;
-        if(!custom_bitvector_domaint::has_get_must_or_may(i_it->guard))
-          continue;
+        custom_bitvector_analysis.output(ns, goto_functions, std::cout);
+        return false;
+      }
 
-        if(custom_bitvector_analysis[i_it].has_values.is_false())
+      forall_goto_functions(f_it, goto_functions)
+      {
+        if(!f_it->second.body.has_assertion())
           continue;
 
-        exprt result=custom_bitvector_analysis.eval(i_it->guard, i_it);
-        exprt result2=simplify_expr(result, ns);
+        const symbolt &symbol=ns.lookup(f_it->first);
 
-        if(result2.is_true())
+        if(f_it->first=="__actual_thread_spawn")
           continue;
 
-        if(first)
-        {
-          first=false;
-          if(!use_json)
-            std::cout << "\n"
-                      << "******** Function " << symbol.display_name() << '\n';
-        }
+        bool first=true;
 
-        if(use_json)
-        {
-          json_objectt json;
-          json["bugClass"]=
-            json_stringt(id2string(i_it->source_location.get_property_class()));
-          json["file"]=
-            json_stringt(id2string(i_it->source_location.get_file()));
-          json["line"]=
-            json_numbert(id2string(i_it->source_location.get_line()));
-          json_result.array.push_back(json);
-        }
-        else
+        forall_goto_program_instructions(i_it, f_it->second.body)
         {
-          std::cout << i_it->source_location;
-          if(!i_it->source_location.get_comment().empty())
-            std::cout << ": " << i_it->source_location.get_comment();
+          if(!i_it->is_assert())
+            continue;
+          if(!custom_bitvector_domaint::has_get_must_or_may(i_it->guard))
+            continue;
+
+          if(custom_bitvector_analysis[i_it].has_values.is_false())
+            continue;
+
+          exprt result=custom_bitvector_analysis.eval(i_it->guard, i_it);
+          exprt result2=simplify_expr(result, ns);
 
-          if(!i_it->source_location.get_property_class().empty())
-            std::cout << " ("
-                      << i_it->source_location.get_property_class() << ")";
+          if(result2.is_true())
+            continue;
 
-          std::cout << '\n';
+          report(symbol, i_it->source_location, first, use_json, json_result);
         }
       }
     }
@@ -416,7 +564,9 @@ bool taint_analysis(
   const std::string &taint_file_name,
   message_handlert &message_handler,
   bool show_full,
-  const std::string &json_file_name)
+  const std::string &json_file_name,
+  bool use_summaries,
+  const std::string &summary_cache_file_name)
 {
   taint_analysist taint_analysis;
   taint_analysis.set_message_handler(message_handler);
@@ -425,5 +575,7 @@ bool taint_analysis(
     goto_model.symbol_table,
     goto_model.goto_functions,
     show_full,
-    json_file_name);
+    json_file_name,
+    use_summaries,
+    summary_cache_file_name);
 }
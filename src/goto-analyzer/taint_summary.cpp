@@ -0,0 +1,1004 @@
+/*******************************************************************\
+
+Module: Taint Summaries
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Taint Summaries
+
+#include "taint_summary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <util/find_symbols.h>
+#include <util/graph.h>
+#include <util/prefix.h>
+
+#include <json/json_parser.h>
+
+#include <analyses/call_graph.h>
+#include <analyses/custom_bitvector_analysis.h>
+
+bool taint_summaryt::sinkt::operator<(const sinkt &other) const
+{
+  // compare the strings, as the order of the summaries in the cache
+  // must not depend on the numbering of the identifiers
+  int c=function.compare(other.function);
+  if(c!=0)
+    return c<0;
+
+  c=source_location.get_file().compare(other.source_location.get_file());
+  if(c!=0)
+    return c<0;
+
+  c=source_location.get_line().compare(other.source_location.get_line());
+  if(c!=0)
+    return c<0;
+
+  c=source_location.get_property_class().compare(
+    other.source_location.get_property_class());
+  if(c!=0)
+    return c<0;
+
+  c=source_location.get_comment().compare(
+    other.source_location.get_comment());
+  if(c!=0)
+    return c<0;
+
+  if(taint!=other.taint)
+    return taint<other.taint;
+
+  return object<other.object;
+}
+
+static json_arrayt taints_json(const taint_summaryt::taintst &taints)
+{
+  json_arrayt json;
+
+  for(const auto &taint : taints)
+    json.push_back(json_stringt(taint));
+
+  return json;
+}
+
+static taint_summaryt::taintst taints_from_json(const jsont &json)
+{
+  taint_summaryt::taintst taints;
+
+  for(const auto &taint : json.array)
+    taints.insert(taint.value);
+
+  return taints;
+}
+
+jsont taint_summaryt::output_json() const
+{
+  json_objectt json;
+
+  json_arrayt &json_objects=json["objects"].make_array();
+
+  for(const auto &object : objects)
+  {
+    json_objectt &json_object=json_objects.push_back().make_object();
+    json_object["object"]=json_stringt(object.first);
+    json_object["taints"]=taints_json(object.second.taints);
+
+    json_arrayt &json_flows=json_object["flows"].make_array();
+
+    for(const auto &flow : object.second.flows)
+    {
+      json_objectt &json_flow=json_flows.push_back().make_object();
+      json_flow["from"]=json_stringt(flow.first);
+      json_flow["taints"]=taints_json(flow.second);
+    }
+  }
+
+  json_arrayt &json_sinks=json["sinks"].make_array();
+
+  for(const auto &sink : sinks)
+  {
+    const source_locationt &l=sink.source_location;
+
+    json_objectt &json_sink=json_sinks.push_back().make_object();
+    json_sink["function"]=json_stringt(id2string(sink.function));
+    json_sink["file"]=json_stringt(id2string(l.get_file()));
+    json_sink["line"]=json_stringt(id2string(l.get_line()));
+    json_sink["column"]=json_stringt(id2string(l.get_column()));
+    json_sink["locationFunction"]=json_stringt(id2string(l.get_function()));
+    json_sink["comment"]=json_stringt(id2string(l.get_comment()));
+    json_sink["propertyClass"]=
+      json_stringt(id2string(l.get_property_class()));
+    json_sink["taint"]=json_stringt(sink.taint);
+    json_sink["object"]=json_stringt(sink.object);
+  }
+
+  return std::move(json);
+}
+
+bool taint_summaryt::from_json(const jsont &json)
+{
+  objects.clear();
+  sinks.clear();
+
+  if(!json.is_object() ||
+     !json["objects"].is_array() ||
+     !json["sinks"].is_array())
+    return true;
+
+  for(const auto &json_object : json["objects"].array)
+  {
+    objectt &object=objects[json_object["object"].value];
+    object.taints=taints_from_json(json_object["taints"]);
+
+    for(const auto &json_flow : json_object["flows"].array)
+      object.flows[json_flow["from"].value]=
+        taints_from_json(json_flow["taints"]);
+  }
+
+  for(const auto &json_sink : json["sinks"].array)
+  {
+    sinkt sink;
+    sink.function=json_sink["function"].value;
+
+    source_locationt &l=sink.source_location;
+
+    // only set what is there, as empty fields are not printed
+    if(!json_sink["file"].value.empty())
+      l.set_file(json_sink["file"].value);
+    if(!json_sink["line"].value.empty())
+      l.set_line(json_sink["line"].value);
+    if(!json_sink["column"].value.empty())
+      l.set_column(json_sink["column"].value);
+    if(!json_sink["locationFunction"].value.empty())
+      l.set_function(json_sink["locationFunction"].value);
+    if(!json_sink["comment"].value.empty())
+      l.set_comment(json_sink["comment"].value);
+    if(!json_sink["propertyClass"].value.empty())
+      l.set_property_class(json_sink["propertyClass"].value);
+
+    sink.taint=json_sink["taint"].value;
+    sink.object=json_sink["object"].value;
+
+    sinks.insert(sink);
+  }
+
+  return false;
+}
+
+/// the format of the cache files, to be changed with the format or with
+/// what the keys are made of
+static const char cache_version[]="1";
+
+bool taint_summary_cachet::read(const std::string &file_name)
+{
+  entries.clear();
+
+  // a missing cache is an empty one
+  if(!std::ifstream(file_name))
+    return false;
+
+  jsont json;
+
+  // the caller reports the failure
+  null_message_handlert null_message_handler;
+
+  if(parse_json(file_name, null_message_handler, json) ||
+     json["version"].value!=cache_version ||
+     !json["entries"].is_array())
+    return true;
+
+  for(const auto &json_entry : json["entries"].array)
+  {
+    const std::string &key=json_entry["key"].value;
+
+    if(key.empty())
+    {
+      entries.clear();
+      return true;
+    }
+
+    entryt &entry=entries[key];
+    entry.taints=json_entry["taints"].value;
+    entry.used=false;
+
+    if(entry.summary.from_json(json_entry["summary"]))
+    {
+      entries.clear();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool taint_summary_cachet::write(const std::string &file_name) const
+{
+  json_objectt json;
+  json["version"]=json_stringt(cache_version);
+  json_arrayt &json_entries=json["entries"].make_array();
+
+  for(const auto &entry : entries)
+  {
+    // drop the summaries of functions that have changed
+    if(!entry.second.used && entry.second.taints==taints)
+      continue;
+
+    json_objectt &json_entry=json_entries.push_back().make_object();
+    json_entry["key"]=json_stringt(entry.first);
+    json_entry["taints"]=json_stringt(entry.second.taints);
+    json_entry["summary"]=entry.second.summary.output_json();
+  }
+
+  std::ofstream out(file_name);
+
+  if(!out)
+    return true;
+
+  out << json << '\n';
+
+  return !out;
+}
+
+const taint_summaryt *taint_summary_cachet::find(const std::string &key)
+{
+  entriest::iterator it=entries.find(key);
+
+  if(it==entries.end())
+    return nullptr;
+
+  it->second.used=true;
+  return &it->second.summary;
+}
+
+void taint_summary_cachet::insert(
+  const std::string &key,
+  const taint_summaryt &summary)
+{
+  entryt &entry=entries[key];
+  entry.taints=taints;
+  entry.summary=summary;
+  entry.used=true;
+}
+
+/// A hash that does not depend on the process, unlike the hashes of
+/// ireps, which use the numbers of the strings
+class stable_hasht
+{
+public:
+  stable_hasht():h(14695981039346656037ull)
+  {
+  }
+
+  // FNV-1a
+  void operator()(const std::string &s)
+  {
+    for(const auto c : s)
+    {
+      h^=static_cast<unsigned char>(c);
+      h*=1099511628211ull;
+    }
+
+    // separate the strings
+    h^=0xff;
+    h*=1099511628211ull;
+  }
+
+  void operator()(const irept &irep)
+  {
+    (*this)(id2string(irep.id()));
+
+    (*this)("(");
+    forall_irep(it, irep.get_sub())
+      (*this)(*it);
+    (*this)(")");
+
+    forall_named_irep(it, irep.get_named_sub())
+    {
+      (*this)(id2string(it->first));
+      (*this)(it->second);
+    }
+  }
+
+  std::string str() const
+  {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << h;
+    return out.str();
+  }
+
+protected:
+  std::uint64_t h;
+};
+
+/// Intraprocedural taint analysis of one function at a time, which
+/// applies the summaries of the callees at the call sites. The objects of
+/// the interface of the function are given an input label per taint at
+/// the beginning, and the labels found at the end tell which taint flows
+/// where.
+class taint_summary_analysist:public custom_bitvector_analysist
+{
+public:
+  taint_summary_analysist(
+    const goto_functionst &goto_functions,
+    const namespacet &_ns,
+    const std::set<std::string> &_taints,
+    const taint_summariest &_summaries):
+    ns(_ns),
+    taints(_taints),
+    summaries(_summaries)
+  {
+    local_may_alias_factory(goto_functions);
+  }
+
+  taint_summaryt summarize(
+    const irep_idt &function,
+    const goto_functionst::goto_functiont &);
+
+  /// the global objects of the interface of \p function
+  std::set<std::string> global_objects(
+    const irep_idt &function,
+    const goto_functionst::goto_functiont &);
+
+protected:
+  typedef custom_bitvector_domaint::bit_vectort bit_vectort;
+
+  const namespacet &ns;
+  const std::set<std::string> &taints;
+  const taint_summariest &summaries;
+
+  /// the input labels: object and taint
+  typedef std::map<unsigned, std::pair<std::string, std::string>> labelst;
+  labelst labels;
+
+  unsigned label(const std::string &object, const std::string &taint);
+  const std::string &taint_of(unsigned bit_nr) const;
+
+  void interface_objects(
+    const std::string &object,
+    const typet &,
+    bool dereferenced,
+    std::set<std::string> &dest) const;
+
+  std::string caller_object(
+    const std::string &object,
+    locationt call) const;
+
+  const taint_summaryt *callee_summary(locationt call) const;
+
+  bit_vectort get_may(
+    const custom_bitvector_domaint &,
+    const std::string &object) const;
+
+  void transform_local_call(
+    locationt call,
+    custom_bitvector_domaint &) override;
+
+  void add_sinks(
+    const bit_vectort &,
+    const taint_summaryt::sinkt &,
+    taint_summaryt::sinkst &) const;
+};
+
+unsigned taint_summary_analysist::label(
+  const std::string &object,
+  const std::string &taint)
+{
+  // the blank cannot be part of the name of a taint
+  unsigned bit_nr=bits.number("#input "+taint+" "+object);
+  labels[bit_nr]=std::make_pair(object, taint);
+  return bit_nr;
+}
+
+const std::string &taint_summary_analysist::taint_of(unsigned bit_nr) const
+{
+  labelst::const_iterator it=labels.find(bit_nr);
+
+  if(it==labels.end())
+    return id2string(bits[bit_nr]);
+
+  return it->second.second;
+}
+
+/// Adds \p object and its members, and, if it is a pointer, the object
+/// it points to
+void taint_summary_analysist::interface_objects(
+  const std::string &object,
+  const typet &type,
+  bool dereferenced,
+  std::set<std::string> &dest) const
+{
+  dest.insert(object);
+
+  const typet &followed=ns.follow(type);
+
+  if(followed.id()==ID_struct || followed.id()==ID_union)
+  {
+    for(const auto &c : to_struct_union_type(followed).components())
+      interface_objects(
+        object+"."+id2string(c.get_name()), c.type(), dereferenced, dest);
+  }
+  else if(followed.id()==ID_pointer && !dereferenced)
+  {
+    interface_objects("*"+object, followed.subtype(), true, dest);
+  }
+}
+
+std::set<std::string> taint_summary_analysist::global_objects(
+  const irep_idt &function,
+  const goto_functionst::goto_functiont &goto_function)
+{
+  find_symbols_sett symbols;
+
+  forall_goto_program_instructions(i_it, goto_function.body)
+  {
+    find_symbols(i_it->code, symbols);
+    find_symbols(i_it->guard, symbols);
+  }
+
+  std::set<std::string> result;
+
+  for(const auto &identifier : symbols)
+  {
+    const symbolt *symbol;
+    if(!ns.lookup(identifier, symbol) &&
+       symbol->is_static_lifetime &&
+       symbol->type.id()!=ID_code)
+      interface_objects(id2string(identifier), symbol->type, false, result);
+  }
+
+  // the callees may modify globals that are not mentioned here
+  forall_goto_program_instructions(i_it, goto_function.body)
+  {
+    const taint_summaryt *summary=callee_summary(i_it);
+    if(summary==nullptr)
+      continue;
+
+    const code_typet &code_type=
+      to_code_type(
+        ns.lookup(
+          to_symbol_expr(
+            to_code_function_call(i_it->code).function()).get_identifier())
+          .type);
+
+    std::set<std::string> parameter_objects;
+    for(const auto &p : code_type.parameters())
+      if(!p.get_identifier().empty())
+        interface_objects(
+          id2string(p.get_identifier()), p.type(), false, parameter_objects);
+
+    for(const auto &object : summary->objects)
+    {
+      if(parameter_objects.find(object.first)==parameter_objects.end())
+        result.insert(object.first);
+
+      for(const auto &flow : object.second.flows)
+        if(parameter_objects.find(flow.first)==parameter_objects.end())
+          result.insert(flow.first);
+    }
+
+    for(const auto &sink : summary->sinks)
+      if(!sink.object.empty() &&
+         parameter_objects.find(sink.object)==parameter_objects.end())
+        result.insert(sink.object);
+  }
+
+  return result;
+}
+
+const taint_summaryt *taint_summary_analysist::callee_summary(
+  locationt call) const
+{
+  if(!call->is_function_call())
+    return nullptr;
+
+  const exprt &function=to_code_function_call(call->code).function();
+
+  if(function.id()!=ID_symbol)
+    return nullptr;
+
+  taint_summariest::const_iterator it=
+    summaries.find(to_symbol_expr(function).get_identifier());
+
+  if(it==summaries.end())
+    return nullptr;
+
+  return &it->second;
+}
+
+/// Renames an object of the interface of the callee of \p call into one
+/// of the caller
+/// \return the object, or the empty string if it has no name
+std::string taint_summary_analysist::caller_object(
+  const std::string &object,
+  locationt call) const
+{
+  const code_function_callt &code_function_call=
+    to_code_function_call(call->code);
+  const code_typet &code_type=
+    to_code_type(
+      ns.lookup(
+        to_symbol_expr(code_function_call.function()).get_identifier()).type);
+
+  const code_function_callt::argumentst &arguments=
+    code_function_call.arguments();
+
+  for(std::size_t i=0; i<code_type.parameters().size(); i++)
+  {
+    const std::string &parameter=
+      id2string(code_type.parameters()[i].get_identifier());
+
+    if(parameter.empty())
+      continue;
+
+    bool dereferenced=has_prefix(object, "*");
+    std::size_t offset=dereferenced?1:0;
+
+    if(object.compare(offset, parameter.size(), parameter)!=0 ||
+       (object.size()>offset+parameter.size() &&
+        object[offset+parameter.size()]!='.'))
+      continue;
+
+    // there may be a mismatch in the number of arguments
+    if(i>=arguments.size())
+      return std::string();
+
+    const irep_idt argument=
+      custom_bitvector_domaint::object2id(
+        dereferenced?dereference_exprt(arguments[i]):arguments[i]);
+
+    if(argument.empty())
+      return std::string();
+
+    return id2string(argument)+object.substr(offset+parameter.size());
+  }
+
+  // a global
+  return object;
+}
+
+custom_bitvector_domaint::bit_vectort taint_summary_analysist::get_may(
+  const custom_bitvector_domaint &state,
+  const std::string &object) const
+{
+  const auto object_nr=objects.get_number(object);
+
+  if(!object_nr.has_value())
+    return bit_vectort();
+
+  return state.get_rhs(*object_nr).may_bits;
+}
+
+void taint_summary_analysist::transform_local_call(
+  locationt call,
+  custom_bitvector_domaint &state)
+{
+  const taint_summaryt *summary=callee_summary(call);
+
+  if(summary==nullptr)
+    return;
+
+  // read all inputs before any object is modified
+  std::map<std::string, bit_vectort> inputs;
+
+  for(const auto &object : summary->objects)
+    for(const auto &flow : object.second.flows)
+      if(inputs.find(flow.first)==inputs.end())
+        inputs[flow.first]=get_may(state, caller_object(flow.first, call));
+
+  for(const auto &object : summary->objects)
+  {
+    const std::string target=caller_object(object.first, call);
+
+    if(target.empty())
+      continue;
+
+    custom_bitvector_domaint::vectorst vectors;
+
+    for(const auto &taint : object.second.taints)
+      vectors.may_bits.set_bit(bits.number(taint));
+
+    for(const auto &flow : object.second.flows)
+    {
+      const bit_vectort &input=inputs[flow.first];
+
+      for(unsigned i=0; i<input.words.size()*bit_vectort::word_bits; i++)
+        if(input.get_bit(i) &&
+           flow.second.find(taint_of(i))!=flow.second.end())
+          vectors.may_bits.set_bit(i);
+    }
+
+    state.assign_lhs(objects.number(target), vectors, *this);
+  }
+}
+
+/// Adds the sinks that \p bits may trigger, given that \p sink fails
+/// when it is reached with its taint
+void taint_summary_analysist::add_sinks(
+  const bit_vectort &bits,
+  const taint_summaryt::sinkt &sink,
+  taint_summaryt::sinkst &dest) const
+{
+  for(unsigned i=0; i<bits.words.size()*bit_vectort::word_bits; i++)
+  {
+    if(!bits.get_bit(i) || taint_of(i)!=sink.taint)
+      continue;
+
+    taint_summaryt::sinkt new_sink=sink;
+
+    labelst::const_iterator l_it=labels.find(i);
+    new_sink.object=l_it==labels.end()?std::string():l_it->second.first;
+
+    dest.insert(new_sink);
+  }
+}
+
+taint_summaryt taint_summary_analysist::summarize(
+  const irep_idt &function,
+  const goto_functionst::goto_functiont &goto_function)
+{
+  const goto_programt &body=goto_function.body;
+
+  std::set<std::string> interface=global_objects(function, goto_function);
+
+  for(const auto &p : goto_function.type.parameters())
+    if(!p.get_identifier().empty())
+      interface_objects(
+        id2string(p.get_identifier()), p.type(), false, interface);
+
+  // the states of the previous function are not needed anymore
+  clear();
+  ait<custom_bitvector_domaint>::initialize(goto_function);
+  entry_state(body);
+
+  custom_bitvector_domaint &entry=
+    static_cast<custom_bitvector_domaint &>(
+      get_state(body.instructions.begin()));
+
+  for(const auto &object : interface)
+  {
+    custom_bitvector_domaint::vectorst vectors;
+
+    for(const auto &taint : taints)
+      vectors.may_bits.set_bit(label(object, taint));
+
+    entry.assign_lhs(objects.number(object), vectors, *this);
+  }
+
+  entry.has_values=tvt::unknown();
+
+  const goto_functionst no_functions;
+  ai_baset::fixedpoint(body, no_functions, ns);
+  finalize();
+
+  taint_summaryt summary;
+
+  const custom_bitvector_domaint &exit=(*this)[--body.instructions.end()];
+
+  if(!exit.has_values.is_false())
+  {
+    for(const auto &object : interface)
+    {
+      const bit_vectort may=get_may(exit, object);
+      taint_summaryt::objectt result;
+
+      for(unsigned i=0; i<may.words.size()*bit_vectort::word_bits; i++)
+      {
+        if(!may.get_bit(i))
+          continue;
+
+        labelst::const_iterator l_it=labels.find(i);
+
+        if(l_it==labels.end())
+          result.taints.insert(id2string(bits[i]));
+        else
+          result.flows[l_it->second.first].insert(l_it->second.second);
+      }
+
+      // leave out the objects that keep their taint
+      if(result.taints.empty() &&
+         result.flows.size()==1 &&
+         result.flows.begin()->first==object &&
+         result.flows.begin()->second==taints)
+        continue;
+
+      summary.objects[object]=result;
+    }
+  }
+
+  forall_goto_program_instructions(i_it, body)
+  {
+    const custom_bitvector_domaint &state=(*this)[i_it];
+
+    if(state.has_values.is_false())
+      continue;
+
+    if(i_it->is_assert() &&
+       i_it->guard.id()==ID_not &&
+       i_it->guard.op0().id()=="get_may" &&
+       i_it->guard.op0().operands().size()==2)
+    {
+      // the assertions of sink rules
+      const exprt &get_may=i_it->guard.op0();
+      const exprt &pointer=get_may.op0();
+
+      if(pointer.type().id()!=ID_pointer ||
+         (pointer.is_constant() &&
+          to_constant_expr(pointer).get_value()==ID_NULL))
+        continue;
+
+      taint_summaryt::sinkt sink;
+      sink.function=function;
+      sink.source_location=i_it->source_location;
+      sink.taint=id2string(bits[get_bit_nr(get_may.op1())]);
+
+      add_sinks(
+        state.get_rhs(dereference_exprt(pointer), *this).may_bits,
+        sink,
+        summary.sinks);
+    }
+    else if(const taint_summaryt *callee=callee_summary(i_it))
+    {
+      // the assertions in the callees that depend on the arguments
+      for(const auto &sink : callee->sinks)
+      {
+        if(sink.object.empty())
+          continue;
+
+        const std::string object=caller_object(sink.object, i_it);
+
+        if(!object.empty())
+          add_sinks(get_may(state, object), sink, summary.sinks);
+      }
+    }
+  }
+
+  return summary;
+}
+
+/// Computes the summaries of the functions of a strongly connected
+/// component of the call graph, iterating until they are stable if the
+/// functions are recursive
+static void summarize_component(
+  const std::vector<irep_idt> &component,
+  bool recursive,
+  const goto_functionst &goto_functions,
+  taint_summary_analysist &analysis,
+  taint_summariest &summaries)
+{
+  for(const auto &function : component)
+    summaries[function]=taint_summaryt();
+
+  bool changed;
+
+  do
+  {
+    changed=false;
+
+    for(const auto &function : component)
+    {
+      taint_summaryt summary=
+        analysis.summarize(
+          function, goto_functions.function_map.at(function));
+
+      if(summary!=summaries[function])
+      {
+        summaries[function]=summary;
+        changed=true;
+      }
+    }
+  }
+  while(changed && recursive);
+}
+
+void taint_summaries(
+  const goto_functionst &goto_functions,
+  const namespacet &ns,
+  const std::set<std::string> &taints,
+  taint_summary_cachet &cache,
+  taint_summariest &summaries,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  stable_hasht taints_hash;
+  for(const auto &taint : taints)
+    taints_hash(taint);
+
+  cache.set_taints(taints_hash.str());
+
+  // the functions with a body are the nodes of the call graph
+  std::vector<irep_idt> functions;
+  std::map<irep_idt, std::size_t> function_nr;
+
+  forall_goto_functions(f_it, goto_functions)
+    if(f_it->second.body_available())
+    {
+      function_nr[f_it->first]=functions.size();
+      functions.push_back(f_it->first);
+    }
+
+  grapht<graph_nodet<empty_edget>> graph;
+  graph.resize(functions.size());
+
+  const call_grapht call_graph(goto_functions);
+  std::set<std::size_t> self_calls;
+
+  for(const auto &edge : call_graph.graph)
+  {
+    std::map<irep_idt, std::size_t>::const_iterator
+      caller=function_nr.find(edge.first),
+      callee=function_nr.find(edge.second);
+
+    if(caller==function_nr.end() || callee==function_nr.end())
+      continue;
+
+    graph.add_edge(caller->second, callee->second);
+
+    if(caller->second==callee->second)
+      self_calls.insert(caller->second);
+  }
+
+  // the callees are in components with smaller numbers
+  std::vector<std::size_t> component_nr;
+  std::size_t number_of_components=graph.SCCs(component_nr);
+
+  std::vector<std::vector<irep_idt>> components(number_of_components);
+  for(std::size_t i=0; i<functions.size(); i++)
+    components[component_nr[i]].push_back(functions[i]);
+
+  taint_summary_analysist analysis(goto_functions, ns, taints, summaries);
+
+  std::size_t computed=0, cached=0;
+
+  for(auto &component : components)
+  {
+    // the order must not depend on the numbering of the identifiers
+    std::sort(
+      component.begin(),
+      component.end(),
+      [](const irep_idt &a, const irep_idt &b) { return a.compare(b)<0; });
+
+    // the key is made of the bodies of the component and the summaries
+    // of the functions it calls
+    stable_hasht component_hash;
+    component_hash(taints_hash.str());
+
+    std::set<std::string> callees;
+    find_symbols_sett type_symbols;
+
+    for(const auto &function : component)
+    {
+      component_hash(id2string(function));
+
+      const goto_functionst::goto_functiont &goto_function=
+        goto_functions.function_map.at(function);
+      const goto_programt &body=goto_function.body;
+
+      // the parameters are part of the interface
+      component_hash(goto_function.type);
+      find_type_symbols(goto_function.type, type_symbols);
+
+      // the targets are hashed as the positions of the instructions
+      std::map<goto_programt::const_targett, std::size_t> index;
+      forall_goto_program_instructions(i_it, body)
+      {
+        std::size_t position=index.size();
+        index[i_it]=position;
+      }
+
+      forall_goto_program_instructions(i_it, body)
+      {
+        component_hash(std::to_string(i_it->type));
+        component_hash(i_it->code);
+        component_hash(i_it->guard);
+        component_hash(i_it->source_location.as_string());
+        component_hash(id2string(i_it->source_location.get_comment()));
+        component_hash(
+          id2string(i_it->source_location.get_property_class()));
+
+        for(const auto &t : i_it->targets)
+          component_hash(std::to_string(index[t]));
+
+        find_type_symbols(i_it->code, type_symbols);
+        find_type_symbols(i_it->guard, type_symbols);
+      }
+
+      for(auto c_it=call_graph.graph.lower_bound(function);
+          c_it!=call_graph.graph.upper_bound(function);
+          c_it++)
+        if(std::find(component.begin(), component.end(), c_it->second)==
+           component.end())
+          callees.insert(id2string(c_it->second));
+    }
+
+    // the members of the structs and unions that the objects have
+    // determine the objects of the interface
+    std::set<std::string> types;
+    std::vector<irep_idt> type_worklist(
+      type_symbols.begin(), type_symbols.end());
+
+    while(!type_worklist.empty())
+    {
+      const irep_idt identifier=type_worklist.back();
+      type_worklist.pop_back();
+
+      const symbolt *symbol;
+      if(!types.insert(id2string(identifier)).second ||
+         ns.lookup(identifier, symbol))
+        continue;
+
+      find_symbols_sett new_type_symbols;
+      find_type_symbols(symbol->type, new_type_symbols);
+      type_worklist.insert(
+        type_worklist.end(), new_type_symbols.begin(), new_type_symbols.end());
+    }
+
+    for(const auto &type : types)
+    {
+      component_hash(type);
+
+      const symbolt *symbol;
+      if(!ns.lookup(type, symbol))
+        component_hash(symbol->type);
+    }
+
+    for(const auto &callee : callees)
+    {
+      component_hash(callee);
+
+      taint_summariest::const_iterator s_it=summaries.find(callee);
+      if(s_it!=summaries.end())
+      {
+        std::ostringstream summary_json;
+        summary_json << s_it->second.output_json();
+        component_hash(summary_json.str());
+      }
+    }
+
+    std::vector<std::string> keys;
+    bool found=true;
+
+    for(const auto &function : component)
+    {
+      stable_hasht key=component_hash;
+      key(id2string(function));
+      keys.push_back(key.str());
+
+      const taint_summaryt *summary=cache.find(keys.back());
+
+      if(summary==nullptr)
+        found=false;
+      else
+        summaries[function]=*summary;
+    }
+
+    if(found)
+    {
+      cached+=component.size();
+      continue;
+    }
+
+    summarize_component(
+      component,
+      component.size()>1 ||
+        self_calls.find(function_nr[component.front()])!=self_calls.end(),
+      goto_functions,
+      analysis,
+      summaries);
+
+    computed+=component.size();
+
+    for(std::size_t i=0; i<component.size(); i++)
+      cache.insert(keys[i], summaries[component[i]]);
+  }
+
+  message.statistics() << "Taint summaries: " << computed << " computed, "
+                       << cached << " from the cache" << messaget::eom;
+}
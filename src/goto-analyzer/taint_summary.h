@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: Taint Summaries
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Taint Summaries
+
+#ifndef CPROVER_GOTO_ANALYZER_TAINT_SUMMARY_H
+#define CPROVER_GOTO_ANALYZER_TAINT_SUMMARY_H
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <util/json.h>
+#include <util/message.h>
+#include <util/namespace.h>
+#include <util/source_location.h>
+
+#include <goto-programs/goto_functions.h>
+
+/// The effect of a function on the taint of the objects that its callers
+/// can observe, i.e., its parameters, the objects they point to and global
+/// variables, and the sinks the function may reach. Objects are named as
+/// in custom_bitvector_domaint, in terms of the parameters of the function.
+class taint_summaryt
+{
+public:
+  typedef std::set<std::string> taintst;
+
+  /// The taint of an object at the end of the function
+  struct objectt
+  {
+    /// the taint the object gains in the function
+    taintst taints;
+
+    /// for each object, the taint that may flow from its value at the
+    /// beginning of the function
+    std::map<std::string, taintst> flows;
+
+    bool operator==(const objectt &other) const
+    {
+      return taints==other.taints && flows==other.flows;
+    }
+  };
+
+  /// the objects the function may modify; all others keep their taint
+  typedef std::map<std::string, objectt> objectst;
+  objectst objects;
+
+  /// An assertion of a sink rule that may fail
+  struct sinkt
+  {
+    irep_idt function;
+    source_locationt source_location;
+    std::string taint;
+
+    /// empty if the assertion may fail no matter what the function is
+    /// called with, and otherwise the object that must carry the taint
+    /// at the beginning of the function for it to fail
+    std::string object;
+
+    bool operator<(const sinkt &other) const;
+
+    bool operator==(const sinkt &other) const
+    {
+      return !(*this<other) && !(other<*this);
+    }
+  };
+
+  typedef std::set<sinkt> sinkst;
+  sinkst sinks;
+
+  bool operator==(const taint_summaryt &other) const
+  {
+    return objects==other.objects && sinks==other.sinks;
+  }
+
+  bool operator!=(const taint_summaryt &other) const
+  {
+    return !(*this==other);
+  }
+
+  jsont output_json() const;
+
+  /// \return true iff \p json is not a summary
+  bool from_json(const jsont &json);
+};
+
+/// Summaries kept across runs, keyed by a hash of the functions they
+/// summarize, of the taints and of the summaries of the callees
+class taint_summary_cachet
+{
+public:
+  /// \return true iff the cache could not be read, e.g., as it is
+  ///   corrupt or was written by another version, in which case it is
+  ///   empty
+  bool read(const std::string &file_name);
+
+  /// Writes the entries that were used or added since the cache was
+  /// read, and the entries for other sets of taints
+  /// \return true iff the cache could not be written
+  bool write(const std::string &file_name) const;
+
+  /// Sets the hash of the taints of the summaries to be looked up
+  void set_taints(const std::string &_taints)
+  {
+    taints=_taints;
+  }
+
+  const taint_summaryt *find(const std::string &key);
+  void insert(const std::string &key, const taint_summaryt &);
+
+protected:
+  struct entryt
+  {
+    std::string taints;
+    taint_summaryt summary;
+    bool used;
+  };
+
+  typedef std::map<std::string, entryt> entriest;
+  entriest entries;
+
+  std::string taints;
+};
+
+typedef std::map<irep_idt, taint_summaryt> taint_summariest;
+
+/// Computes the summaries of all functions with a body, callees before
+/// their callers, taking those whose key is in the cache from there
+void taint_summaries(
+  const goto_functionst &,
+  const namespacet &,
+  const std::set<std::string> &taints,
+  taint_summary_cachet &,
+  taint_summariest &,
+  message_handlert &);
+
+#endif // CPROVER_GOTO_ANALYZER_TAINT_SUMMARY_H
@@ -28,6 +28,7 @@ Date: June 2006
 #include <util/irep_serialization.h>
 #include <util/suffix.h>
 #include <util/get_base_name.h>
+#include <util/string2int.h>
 
 #include <ansi-c/ansi_c_language.h>
 #include <ansi-c/ansi_c_entry_point.h>
@@ -60,6 +61,12 @@ Date: June 2006
 #include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <cerrno>
+#endif
+
 #ifdef _WIN32
 #include <direct.h>
 #include <windows.h>
@@ -387,6 +394,27 @@ bool compilet::link()
 /// \return true on error, false otherwise
 bool compilet::compile()
 {
+  unsigned jobs=1;
+  if(cmdline.isset('j'))
+    jobs=unsafe_string2unsigned(cmdline.get_value('j'));
+
+#ifdef _WIN32
+  if(jobs>1)
+  {
+    warning() << "-j is not supported on this platform" << eom;
+    jobs=1;
+  }
+#endif
+
+  // the preprocessed output would be interleaved, and there is
+  // only one stdin
+  if(jobs>1 &&
+     source_files.size()>1 &&
+     mode!=PREPROCESS_ONLY &&
+     std::find(source_files.begin(), source_files.end(), "-")==
+       source_files.end())
+    return compile_parallel(jobs);
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
@@ -400,16 +428,7 @@ bool compilet::compile()
 
     if(r)
     {
-      const std::string &debug_outfile=
-        cmdline.get_value("print-rejected-preprocessed-source");
-      if(!debug_outfile.empty())
-      {
-        std::ifstream in(file_name, std::ios::binary);
-        std::ofstream out(debug_outfile, std::ios::binary);
-        out << in.rdbuf();
-        warning() << "Failed sources in " << debug_outfile << eom;
-      }
-
+      save_rejected_source(file_name);
       return true; // parser/typecheck error
     }
 
@@ -441,6 +460,178 @@ bool compilet::compile()
   return false;
 }
 
+/// copies a source file that failed to parse or typecheck to the file
+/// given with --print-rejected-preprocessed-source, if any
+void compilet::save_rejected_source(const std::string &file_name)
+{
+  const std::string &debug_outfile=
+    cmdline.get_value("print-rejected-preprocessed-source");
+  if(!debug_outfile.empty())
+  {
+    std::ifstream in(file_name, std::ios::binary);
+    std::ofstream out(debug_outfile, std::ios::binary);
+    out << in.rdbuf();
+    warning() << "Failed sources in " << debug_outfile << eom;
+  }
+}
+
+/// compiles the source files in worker processes, at most the given
+/// number at a time, each of which writes an object file. When linking,
+/// these are linked in the order of the source files, and hence the
+/// result does not depend on the order in which the workers finish.
+/// Processes are used rather than threads: each source file is parsed
+/// with the global configuration, and its symbols are added to a symbol
+/// table whose ireps are reference counted without synchronisation.
+/// \return true on error, false otherwise
+bool compilet::compile_parallel(unsigned jobs)
+{
+#ifdef _WIN32
+  UNREACHABLE;
+  return true;
+#else
+  const std::vector<std::string> files(
+    source_files.begin(), source_files.end());
+  std::vector<std::string> objects;
+  objects.reserve(files.size());
+
+  if(mode==COMPILE_ONLY)
+  {
+    for(const auto &file_name : files)
+      objects.push_back(
+        output_file_object==""?
+        get_base_name(file_name, true)+"."+object_file_extension:
+        output_file_object);
+  }
+  else
+  {
+    const std::string tmp_dir=get_temporary_directory("goto-cc-XXXXXX");
+    tmp_dirs.push_back(tmp_dir);
+
+    for(std::size_t i=0; i<files.size(); i++)
+      objects.push_back(tmp_dir+"/"+std::to_string(i)+".gb");
+  }
+
+  statistics() << "Compiling " << files.size() << " source files in "
+               << std::min<std::size_t>(jobs, files.size())
+               << " worker processes" << eom;
+
+  // the workers must not repeat buffered output
+  std::cout << std::flush;
+  std::cerr << std::flush;
+
+  std::map<pid_t, std::size_t> running;
+  std::size_t next=0;
+  bool failed=false;
+
+  while((!failed && next<files.size()) || !running.empty())
+  {
+    if(!failed && next<files.size() && running.size()<jobs)
+    {
+      pid_t pid=fork();
+
+      if(pid==0)
+      {
+        bool worker_failed=compile_worker(files[next], objects[next]);
+        std::cout << std::flush;
+        std::cerr << std::flush;
+        _exit(worker_failed?1:0);
+      }
+      else if(pid==-1)
+      {
+        error() << "failed to start worker process" << eom;
+        failed=true;
+      }
+      else
+        running[pid]=next++;
+
+      continue;
+    }
+
+    int exit_status;
+    pid_t pid=waitpid(-1, &exit_status, 0);
+
+    if(pid==-1)
+    {
+      if(errno==EINTR)
+        continue;
+
+      error() << "failed to wait for worker process" << eom;
+      return true;
+    }
+
+    running.erase(pid);
+
+    if(!WIFEXITED(exit_status) || WEXITSTATUS(exit_status)!=0)
+      failed=true;
+  }
+
+  if(failed)
+    return true;
+
+  source_files.clear();
+
+  if(mode==COMPILE_ONLY)
+  {
+    // collect the CPROVER macros the workers have written
+    for(const auto &object : objects)
+    {
+      symbol_tablet object_symbol_table;
+      goto_functionst object_functions;
+
+      if(read_goto_binary(
+           object,
+           object_symbol_table,
+           object_functions,
+           get_message_handler()))
+        return true;
+
+      wrote_object=true;
+
+      if(add_written_cprover_symbols(object_symbol_table))
+        return true;
+    }
+  }
+  else
+  {
+    // these come first, as sources do in sequential compilation
+    object_files.insert(object_files.begin(), objects.begin(), objects.end());
+  }
+
+  return false;
+#endif
+}
+
+/// compiles one source file into the given object file; this runs in a
+/// worker process
+/// \return true on error, false otherwise
+bool compilet::compile_worker(
+  const std::string &file_name,
+  const std::string &object_file)
+{
+  const unsigned warnings_before=
+    get_message_handler().get_message_count(messaget::M_WARNING);
+
+  // Visual Studio always prints the name of the file it's doing
+  if(echo_file_name)
+    status() << file_name << eom;
+
+  if(parse_source(file_name))
+  {
+    save_rejected_source(file_name);
+    return true;
+  }
+
+  convert_symbols(compiled_functions);
+
+  if(write_object_file(object_file, symbol_table, compiled_functions))
+    return true;
+
+  return
+    warning_is_fatal &&
+    get_message_handler().get_message_count(messaget::M_WARNING)!=
+    warnings_before;
+}
+
 /// parses a source file (low-level parsing)
 /// \return true on error, false otherwise
 bool compilet::parse(const std::string &file_name)
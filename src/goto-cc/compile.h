@@ -62,6 +62,7 @@ public:
   bool link();
 
   bool parse_source(const std::string &);
+  void save_rejected_source(const std::string &);
 
   bool write_object_file(
     const std::string &,
@@ -100,6 +101,11 @@ protected:
 
   void convert_symbols(goto_functionst &dest);
 
+  bool compile_parallel(unsigned jobs);
+  bool compile_worker(
+    const std::string &file_name,
+    const std::string &object_file);
+
   bool add_written_cprover_symbols(const symbol_tablet &symbol_table);
   std::map<irep_idt, symbolt> written_macros;
 
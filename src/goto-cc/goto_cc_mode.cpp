@@ -64,6 +64,7 @@ void goto_cc_modet::help()
   " --native-assembler cmd      command to invoke as assembler (goto-as only)\n"
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
+  " -j #                        compile # source files at a time (gcc mode)\n"
   "\n";
 }
 
@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/unicode.h>
 #include <util/json.h>
 #include <util/exit_codes.h>
+#include <util/make_unique.h>
 
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/remove_function_pointers.h>
@@ -45,6 +46,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_symbol_table.h>
 
 #include <pointer-analysis/value_set_analysis.h>
+#include <pointer-analysis/demand_value_sets.h>
+#include <pointer-analysis/steensgaard.h>
 #include <pointer-analysis/goto_program_dereference.h>
 #include <pointer-analysis/add_failed_symbols.h>
 #include <pointer-analysis/show_value_sets.h>
@@ -130,6 +133,15 @@ int goto_instrument_parse_optionst::doit()
 
   eval_verbosity();
 
+  // the output would lack the bodies that were not loaded, which is
+  // checked before any work is done
+  if(cmdline.args.size()==2 && cmdline.isset("load-reachable-functions"))
+  {
+    error() << "--load-reachable-functions cannot be used when writing "
+            << "a goto binary" << eom;
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
   try
   {
     register_languages();
@@ -793,10 +805,31 @@ void goto_instrument_parse_optionst::do_indirect_call_and_rtti_removal(
   function_pointer_removal_done=true;
 
   status() << "Function Pointer Removal" << eom;
-  remove_function_pointers(
-    get_message_handler(),
-    goto_model,
-    cmdline.isset("pointer-check"));
+
+  if(cmdline.isset("steensgaard"))
+  {
+    // only call the functions the pointers may point to
+    status() << "Unification-Based Pointer Analysis" << eom;
+    const namespacet ns(goto_model.symbol_table);
+    steensgaard_analysist steensgaard(ns);
+    steensgaard(goto_model.goto_functions);
+
+    remove_function_pointers(
+      get_message_handler(),
+      goto_model,
+      cmdline.isset("pointer-check"),
+      false,
+      [&steensgaard](const exprt &pointer, std::set<irep_idt> &targets)
+      {
+        return steensgaard.get_function_targets(pointer, targets);
+      });
+  }
+  else
+    remove_function_pointers(
+      get_message_handler(),
+      goto_model,
+      cmdline.isset("pointer-check"));
+
   status() << "Virtual function removal" << eom;
   remove_virtual_functions(goto_model);
   status() << "Catch and throw removal" << eom;
@@ -856,7 +889,8 @@ void goto_instrument_parse_optionst::get_goto_program()
   status() << "Reading GOTO program from `" << cmdline.args[0] << "'" << eom;
 
   if(read_goto_binary(cmdline.args[0],
-    goto_model, get_message_handler()))
+    goto_model, get_message_handler(),
+    cmdline.isset("load-reachable-functions")))
     throw 0;
 
   config.set(cmdline);
@@ -1164,21 +1198,45 @@ void goto_instrument_parse_optionst::instrument_goto_program()
   {
     do_indirect_call_and_rtti_removal();
 
-    status() << "Pointer Analysis" << eom;
-    value_set_analysist value_set_analysis(ns);
-    value_set_analysis(goto_model.goto_functions);
+    std::unique_ptr<value_setst> value_sets;
+
+    if(cmdline.isset("demand-driven-pointers"))
+    {
+      // the values are computed as the instrumentation asks for them
+      status() << "Collecting Pointer Assignments" << eom;
+      std::unique_ptr<demand_value_setst> demand_value_sets=
+        util_make_unique<demand_value_setst>(ns);
+      (*demand_value_sets)(goto_model.goto_functions);
+      value_sets=std::move(demand_value_sets);
+    }
+    else if(cmdline.isset("steensgaard"))
+    {
+      status() << "Unification-Based Pointer Analysis" << eom;
+      std::unique_ptr<steensgaard_analysist> steensgaard=
+        util_make_unique<steensgaard_analysist>(ns);
+      (*steensgaard)(goto_model.goto_functions);
+      value_sets=std::move(steensgaard);
+    }
+    else
+    {
+      status() << "Pointer Analysis" << eom;
+      std::unique_ptr<value_set_analysist> value_set_analysis=
+        util_make_unique<value_set_analysist>(ns);
+      (*value_set_analysis)(goto_model.goto_functions);
+      value_sets=std::move(value_set_analysis);
+    }
 
     if(cmdline.isset("remove-pointers"))
     {
       // removing pointers
       status() << "Removing Pointers" << eom;
-      remove_pointers(goto_model, value_set_analysis);
+      remove_pointers(goto_model, *value_sets);
     }
 
     if(cmdline.isset("race-check"))
     {
       status() << "Adding Race Checks" << eom;
-      race_check(value_set_analysis, goto_model);
+      race_check(*value_sets, goto_model);
     }
 
     if(cmdline.isset("mm"))
@@ -1254,7 +1312,7 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       if(model!=Unknown)
         weak_memory(
           model,
-          value_set_analysis,
+          *value_sets,
           goto_model,
           cmdline.isset("scc"),
           inst_strategy,
@@ -1278,7 +1336,7 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     {
       status() << "Instrumenting interrupt handler" << eom;
       interrupt(
-        value_set_analysis,
+        *value_sets,
         goto_model,
         cmdline.get_value("isr"));
     }
@@ -1287,13 +1345,13 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     if(cmdline.isset("mmio"))
     {
       status() << "Instrumenting memory-mapped I/O" << eom;
-      mmio(value_set_analysis, goto_model);
+      mmio(*value_sets, goto_model);
     }
 
     if(cmdline.isset("concurrency"))
     {
       status() << "Sequentializing concurrency" << eom;
-      concurrency(value_set_analysis, goto_model);
+      concurrency(*value_sets, goto_model);
     }
   }
 
@@ -1477,6 +1535,8 @@ void goto_instrument_parse_optionst::help()
     " --nondet-static              add nondeterministic initialization of variables with static lifetime\n" // NOLINT(*)
     " --check-invariant function   instruments invariant checking function\n"
     " --remove-pointers            converts pointer arithmetic to base+offset expressions\n" // NOLINT(*)
+    " --demand-driven-pointers     compute the points-to sets the above need on demand\n" // NOLINT(*)
+    " --steensgaard                use a coarse but fast unification-based points-to analysis\n" // NOLINT(*)
     " --splice-call caller,callee  prepends a call to callee in the body of caller\n"  // NOLINT(*)
     // NOLINTNEXTLINE(whitespace/line_length)
     " --undefined-function-is-assume-false\n" // NOLINTNEXTLINE(whitespace/line_length)
@@ -1524,6 +1584,7 @@ void goto_instrument_parse_optionst::help()
     " --remove-function-body <f>   remove the implementation of function <f> (may be repeated)\n"
     "\n"
     "Other options:\n"
+    HELP_GOTO_BINARY_LOADING
     " --no-system-headers          with --dump-c/--dump-cpp: generate C source expanding libc includes\n" // NOLINT(*)
     " --use-all-headers            with --dump-c/--dump-cpp: generate C source with all includes\n" // NOLINT(*)
     " --harness                    with --dump-c/--dump-cpp: include input generator in output\n" // NOLINT(*)
@@ -17,6 +17,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/show_goto_functions.h>
+#include <goto-programs/read_goto_binary.h>
 #include <goto-programs/remove_const_function_pointers.h>
 
 #include <analyses/goto_check.h>
@@ -31,7 +32,7 @@ Author: Daniel Kroening, kroening@kroening.com
   /* no-X-check are deprecated and ignored */ \
   "(no-bounds-check)(no-pointer-check)(no-div-by-zero-check)" \
   "(no-nan-check)" \
-  "(remove-pointers)" \
+  "(remove-pointers)(demand-driven-pointers)(steensgaard)" \
   "(no-simplify)" \
   "(assert-to-assume)" \
   "(no-assertions)(no-assumptions)(uninitialized-check)" \
@@ -49,6 +50,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(stack-depth):(nondet-static)" \
   "(function-enter):(function-exit):(branch):" \
   OPT_SHOW_GOTO_FUNCTIONS \
+  OPT_GOTO_BINARY_LOADING \
   "(drop-unused-functions)" \
   "(show-value-sets)" \
   "(show-global-may-alias)" \
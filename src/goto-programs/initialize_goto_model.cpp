@@ -114,11 +114,17 @@ goto_modelt initialize_goto_model(
     }
   }
 
+  // the entry point is rebuilt when a function is given, and hence
+  // the bodies reachable from the existing one are not sufficient
+  const bool reachable_only=
+    cmdline.isset("load-reachable-functions") && !cmdline.isset("function");
+
   for(const auto &file : binaries)
   {
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, goto_model, message_handler))
+    if(read_object_and_link(
+         file, goto_model, message_handler, reachable_only))
       throw 0;
   }
 
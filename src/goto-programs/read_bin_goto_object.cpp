@@ -13,6 +13,11 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <util/expr_iterator.h>
 #include <util/namespace.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
@@ -20,15 +25,12 @@ Date: June 2006
 
 #include "goto_functions.h"
 
-/// read goto binary format v3
+/// reads the symbol table part of a goto binary
 /// \par parameters: input stream, symbol_table, functions
-/// \return true on error, false otherwise
-bool read_bin_goto_object_v3(
+static void read_bin_symbols(
   std::istream &in,
-  const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler,
   irep_serializationt &irepconverter)
 {
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
@@ -80,98 +82,254 @@ bool read_bin_goto_object_v3(
 
     symbol_table.add(sym);
   }
+}
+
+/// reads the instructions of one function body
+/// \par parameters: input stream, function
+static void read_bin_function_body(
+  std::istream &in,
+  goto_functionst::goto_functiont &f,
+  irep_serializationt &irepconverter)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t i=0; i<ins_count; i++)
+  {
+    goto_programt::targett itarget = f.body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
+
+    irepconverter.reference_convert(in, instruction.code);
+    instruction.function = irepconverter.read_string_ref(in);
+    irepconverter.reference_convert(in, instruction.source_location);
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard.make_nil();
+    irepconverter.reference_convert(in, instruction.guard);
+    irepconverter.read_string_ref(in); // former event
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label=="__CPROVER_HIDE")
+        hidden=true;
+      // The above info is normally in the type of the goto_functiont object,
+      // which should likely be stored in the binary.
+    }
+  }
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      assert(entry!=rev_target_map.end());
+      ins->targets.push_back(entry->second);
+    }
+  }
+
+  f.body.update();
+
+  if(hidden)
+    f.make_hidden();
+}
+
+/// read goto binary format v3
+/// \par parameters: input stream, symbol_table, functions
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v3(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  irep_serializationt &irepconverter)
+{
+  read_bin_symbols(in, symbol_table, functions, irepconverter);
 
-  count=irepconverter.read_gb_word(in); // # of functions
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
 
   for(std::size_t i=0; i<count; i++)
   {
     irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
+    read_bin_function_body(in, functions.function_map[fname], irepconverter);
+  }
 
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+  functions.compute_location_numbers();
 
-    bool hidden=false;
+  return false;
+}
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t i=0; i<ins_count; i++)
+/// read goto binary format v4, which differs from v3 in that the
+/// function bodies are preceded by an index, and that each body is
+/// serialised independently of the others. This permits seeking to the
+/// bodies of the functions reachable from the entry point, and
+/// skipping all others.
+/// \par parameters: input stream, symbol_table, functions, whether to
+///   load the bodies reachable from the entry point only
+/// \return true on error, false otherwise
+bool read_bin_goto_object_v4(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler,
+  irep_serializationt &irepconverter,
+  bool reachable_only)
+{
+  read_bin_symbols(in, symbol_table, functions, irepconverter);
+
+  // the index: name and size in bytes of each body
+  typedef std::vector<std::pair<irep_idt, std::size_t> > indext;
+  indext index;
+  index.resize(irepconverter.read_gb_word(in)); // # of functions
+
+  for(auto &entry : index)
+  {
+    entry.first=irepconverter.read_gb_string(in);
+    entry.second=irepconverter.read_gb_word(in);
+  }
+
+  const std::istream::pos_type bodies_start=in.tellg();
+
+  if(!in)
+  {
+    messaget(message_handler).error()
+      << "failed to read function index of `" << filename << "'"
+      << messaget::eom;
+    return true;
+  }
+
+  // object files without entry point are linked, and need all bodies
+  if(!reachable_only ||
+     !symbol_table.has_symbol(goto_functionst::entry_point()))
+  {
+    for(const auto &entry : index)
     {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      irepconverter.reference_convert(in, instruction.code);
-      instruction.function = irepconverter.read_string_ref(in);
-      irepconverter.reference_convert(in, instruction.source_location);
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard.make_nil();
-      irepconverter.reference_convert(in, instruction.guard);
-      irepconverter.read_string_ref(in); // former event
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
-      {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label=="__CPROVER_HIDE")
-          hidden=true;
-        // The above info is normally in the type of the goto_functiont object,
-        // which should likely be stored in the binary.
-      }
+      irep_serializationt::ireps_containert ic;
+      irep_serializationt body_converter(ic);
+      read_bin_function_body(
+        in, functions.function_map[entry.first], body_converter);
     }
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
+    functions.compute_location_numbers();
+
+    return false;
+  }
+
+  std::unordered_map<irep_idt, std::streamoff, irep_id_hash> offsets;
+  std::streamoff offset=0;
+
+  for(const auto &entry : index)
+  {
+    offsets[entry.first]=offset;
+    offset+=entry.second;
+  }
+
+  // Any function whose name occurs in a reachable body is reachable.
+  // This includes those whose address is taken.
+  std::unordered_set<irep_idt, irep_id_hash> queued;
+  std::vector<irep_idt> queue;
+  queue.push_back(goto_functionst::entry_point());
+  queued.insert(queue.back());
+
+  std::size_t loaded=0;
+
+  while(!queue.empty())
+  {
+    const irep_idt fname=queue.back();
+    queue.pop_back();
+
+    const auto o_it=offsets.find(fname);
+    if(o_it==offsets.end())
+      continue; // no body
+
+    in.seekg(bodies_start+o_it->second);
+
+    goto_functionst::goto_functiont &f=functions.function_map[fname];
+
+    irep_serializationt::ireps_containert ic;
+    irep_serializationt body_converter(ic);
+    read_bin_function_body(in, f, body_converter);
+    loaded++;
+
+    for(const auto &instruction : f.body.instructions)
     {
-      goto_programt::targett ins = tit->first;
+      const exprt &code=instruction.code;
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
+      for(const exprt &e : { code, instruction.guard })
       {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        assert(entry!=rev_target_map.end());
-        ins->targets.push_back(entry->second);
+        for(auto it=e.depth_begin(); it!=e.depth_end(); ++it)
+        {
+          if(it->id()!=ID_symbol)
+            continue;
+
+          const irep_idt &identifier=it->get(ID_identifier);
+
+          if(offsets.find(identifier)!=offsets.end() &&
+             queued.insert(identifier).second)
+            queue.push_back(identifier);
+        }
       }
     }
+  }
 
-    f.body.update();
-
-    if(hidden)
-      f.make_hidden();
+  if(!in)
+  {
+    messaget(message_handler).error()
+      << "failed to read function bodies of `" << filename << "'"
+      << messaget::eom;
+    return true;
   }
 
+  messaget(message_handler).statistics()
+    << "Loaded " << loaded << " of " << index.size()
+    << " function bodies" << messaget::eom;
+
   functions.compute_location_numbers();
 
   return false;
 }
 
 /// reads a goto binary file back into a symbol and a function table
-/// \par parameters: input stream, symbol table, functions
+/// \par parameters: input stream, symbol table, functions, whether to
+///   load the bodies of the functions reachable from the entry point
+///   only (binaries of version 4 and later)
 /// \return true on error, false otherwise
 bool read_bin_goto_object(
   std::istream &in,
   const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  bool reachable_only)
 {
   messaget message(message_handler);
 
@@ -235,6 +393,14 @@ bool read_bin_goto_object(
                                      irepconverter);
       break;
 
+    case 4:
+      return read_bin_goto_object_v4(in, filename,
+                                     symbol_table, functions,
+                                     message_handler,
+                                     irepconverter,
+                                     reachable_only);
+      break;
+
     default:
       message.error() <<
           "The input was compiled with an unsupported version of "
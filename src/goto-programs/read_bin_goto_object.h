@@ -26,6 +26,7 @@ bool read_bin_goto_object(
   const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
-  message_handlert &message_handler);
+  message_handlert &message_handler,
+  bool reachable_only=false);
 
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
@@ -39,17 +39,26 @@ Author:
 bool read_goto_binary(
   const std::string &filename,
   goto_modelt &dest,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  bool reachable_only)
 {
   return read_goto_binary(
-    filename, dest.symbol_table, dest.goto_functions, message_handler);
+    filename,
+    dest.symbol_table,
+    dest.goto_functions,
+    message_handler,
+    reachable_only);
 }
 
+/// \par parameters: whether to load the bodies of the functions reachable
+///   from the entry point only; this has no effect on object files, which
+///   have no entry point, and on binaries of version 3 and earlier
 bool read_goto_binary(
   const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  bool reachable_only)
 {
   #ifdef _MSC_VER
   std::ifstream in(widen(filename), std::ios::binary);
@@ -75,7 +84,12 @@ bool read_goto_binary(
   if(hdr[0]==0x7f && hdr[1]=='G' && hdr[2]=='B' && hdr[3]=='F')
   {
     return read_bin_goto_object(
-      in, filename, symbol_table, goto_functions, message_handler);
+      in,
+      filename,
+      symbol_table,
+      goto_functions,
+      message_handler,
+      reachable_only);
   }
   else if(hdr[0]==0x7f && hdr[1]=='E' && hdr[2]=='L' && hdr[3]=='F')
   {
@@ -90,7 +104,12 @@ bool read_goto_binary(
         {
           in.seekg(elf_reader.section_offset(i));
           return read_bin_goto_object(
-            in, filename, symbol_table, goto_functions, message_handler);
+            in,
+            filename,
+            symbol_table,
+            goto_functions,
+            message_handler,
+            reachable_only);
         }
 
       // section not found
@@ -122,7 +141,12 @@ bool read_goto_binary(
           messaget(message_handler).error() << "failed to read temp binary"
                                             << messaget::eom;
         const bool read_err=read_bin_goto_object(
-          temp_in, filename, symbol_table, goto_functions, message_handler);
+          temp_in,
+          filename,
+          symbol_table,
+          goto_functions,
+          message_handler,
+          reachable_only);
         temp_in.close();
 
         unlink(tempname.c_str());
@@ -217,7 +241,8 @@ bool is_goto_binary(const std::string &filename)
 bool read_object_and_link(
   const std::string &file_name,
   goto_modelt &dest,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  bool reachable_only)
 {
   messaget(message_handler).statistics() << "Reading: "
                                          << file_name << messaget::eom;
@@ -228,7 +253,8 @@ bool read_object_and_link(
   if(read_goto_binary(
       file_name,
       temp_model,
-      message_handler))
+      message_handler,
+      reachable_only))
     return true;
 
   try
@@ -253,7 +279,8 @@ bool read_object_and_link(
   const std::string &file_name,
   symbol_tablet &dest_symbol_table,
   goto_functionst &dest_functions,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  bool reachable_only)
 {
   goto_modelt goto_model;
 
@@ -263,7 +290,8 @@ bool read_object_and_link(
   bool result=read_object_and_link(
     file_name,
     goto_model,
-    message_handler);
+    message_handler,
+    reachable_only);
 
   goto_model.symbol_table.swap(dest_symbol_table);
   goto_model.goto_functions.swap(dest_functions);
@@ -19,16 +19,25 @@ class goto_modelt;
 class message_handlert;
 class symbol_tablet;
 
+#define OPT_GOTO_BINARY_LOADING \
+  "(load-reachable-functions)"
+
+#define HELP_GOTO_BINARY_LOADING \
+  " --load-reachable-functions   load only the function bodies reachable\n" \
+  "                              from the entry point of goto binaries\n"
+
 bool read_goto_binary(
   const std::string &filename,
   symbol_tablet &,
   goto_functionst &,
-  message_handlert &);
+  message_handlert &,
+  bool reachable_only=false);
 
 bool read_goto_binary(
   const std::string &filename,
   goto_modelt &dest,
-  message_handlert &);
+  message_handlert &,
+  bool reachable_only=false);
 
 bool is_goto_binary(const std::string &filename);
 
@@ -36,11 +45,13 @@ bool read_object_and_link(
   const std::string &file_name,
   symbol_tablet &,
   goto_functionst &,
-  message_handlert &);
+  message_handlert &,
+  bool reachable_only=false);
 
 bool read_object_and_link(
   const std::string &file_name,
   goto_modelt &,
-  message_handlert &);
+  message_handlert &,
+  bool reachable_only=false);
 
 #endif // CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
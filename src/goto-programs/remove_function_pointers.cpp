@@ -38,7 +38,8 @@ public:
     symbol_tablet &_symbol_table,
     bool _add_safety_assertion,
     bool only_resolve_const_fps,
-    const goto_functionst &goto_functions);
+    const goto_functionst &goto_functions,
+    const function_pointer_targetst &_function_pointer_targets);
 
   void operator()(goto_functionst &goto_functions);
 
@@ -57,6 +58,9 @@ protected:
   // --remove-const-function-pointers instead of --remove-function-pointers
   bool only_resolve_const_fps;
 
+  // optionally narrows the type-compatible functions
+  function_pointer_targetst function_pointer_targets;
+
   void remove_function_pointer(
     goto_programt &goto_program,
     goto_programt::targett target);
@@ -94,12 +98,14 @@ remove_function_pointerst::remove_function_pointerst(
   message_handlert &_message_handler,
   symbol_tablet &_symbol_table,
   bool _add_safety_assertion, bool only_resolve_const_fps,
-  const goto_functionst &goto_functions):
+  const goto_functionst &goto_functions,
+  const function_pointer_targetst &_function_pointer_targets):
   messaget(_message_handler),
   ns(_symbol_table),
   symbol_table(_symbol_table),
   add_safety_assertion(_add_safety_assertion),
-  only_resolve_const_fps(only_resolve_const_fps)
+  only_resolve_const_fps(only_resolve_const_fps),
+  function_pointer_targets(_function_pointer_targets)
 {
   compute_address_taken_in_symbols(address_taken);
   compute_address_taken_functions(goto_functions, address_taken);
@@ -326,6 +332,12 @@ void remove_function_pointerst::remove_function_pointer(
 
     bool return_value_used=code.lhs().is_not_nil();
 
+    std::set<irep_idt> targets;
+    bool use_targets=
+      function_pointer_targets &&
+      function_pointer_targets(pointer, targets) &&
+      !targets.empty();
+
     // get all type-compatible functions
     // whose address is ever taken
     for(const auto &t : type_map)
@@ -334,6 +346,10 @@ void remove_function_pointerst::remove_function_pointer(
       if(address_taken.find(t.first)==address_taken.end())
         continue;
 
+      // may the pointer point to it?
+      if(use_targets && targets.find(t.first)==targets.end())
+        continue;
+
       // type-compatible?
       if(!is_type_compatible(return_value_used, call_type, t.second))
         continue;
@@ -483,7 +499,8 @@ bool remove_function_pointers(message_handlert &_message_handler,
   const goto_functionst &goto_functions,
   goto_programt &goto_program,
   bool add_safety_assertion,
-  bool only_remove_const_fps)
+  bool only_remove_const_fps,
+  const function_pointer_targetst &function_pointer_targets)
 {
   remove_function_pointerst
     rfp(
@@ -491,7 +508,8 @@ bool remove_function_pointers(message_handlert &_message_handler,
       symbol_table,
       add_safety_assertion,
       only_remove_const_fps,
-      goto_functions);
+      goto_functions,
+      function_pointer_targets);
 
   return rfp.remove_function_pointers(goto_program);
 }
@@ -501,7 +519,8 @@ void remove_function_pointers(
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
   bool add_safety_assertion,
-  bool only_remove_const_fps)
+  bool only_remove_const_fps,
+  const function_pointer_targetst &function_pointer_targets)
 {
   remove_function_pointerst
     rfp(
@@ -509,7 +528,8 @@ void remove_function_pointers(
       symbol_table,
       add_safety_assertion,
       only_remove_const_fps,
-      goto_functions);
+      goto_functions,
+      function_pointer_targets);
 
   rfp(goto_functions);
 }
@@ -517,12 +537,14 @@ void remove_function_pointers(
 void remove_function_pointers(message_handlert &_message_handler,
   goto_modelt &goto_model,
   bool add_safety_assertion,
-  bool only_remove_const_fps)
+  bool only_remove_const_fps,
+  const function_pointer_targetst &function_pointer_targets)
 {
   remove_function_pointers(
     _message_handler,
     goto_model.symbol_table,
     goto_model.goto_functions,
     add_safety_assertion,
-    only_remove_const_fps);
+    only_remove_const_fps,
+    function_pointer_targets);
 }
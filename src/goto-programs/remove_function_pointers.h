@@ -14,23 +14,37 @@ Date: June 2003
 #ifndef CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
 #define CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
 
+#include <functional>
+#include <set>
+
 #include "goto_model.h"
 #include <util/message.h>
 
+/// Adds to the given set the functions that the given pointer may point
+/// to, as a points-to analysis computes them, and returns false if these
+/// are not known. Only the type-compatible functions whose address is
+/// taken that are in the set are then called.
+typedef std::function<bool(const exprt &pointer, std::set<irep_idt> &)>
+  function_pointer_targetst;
+
 // remove indirect function calls
 // and replace by case-split
 void remove_function_pointers(
   message_handlert &_message_handler,
   goto_modelt &goto_model,
   bool add_safety_assertion,
-  bool only_remove_const_fps=false);
+  bool only_remove_const_fps=false,
+  const function_pointer_targetst &function_pointer_targets=
+    function_pointer_targetst());
 
 void remove_function_pointers(
   message_handlert &_message_handler,
   symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
   bool add_safety_assertion,
-  bool only_remove_const_fps=false);
+  bool only_remove_const_fps=false,
+  const function_pointer_targetst &function_pointer_targets=
+    function_pointer_targetst());
 
 bool remove_function_pointers(
   message_handlert &_message_handler,
@@ -38,6 +52,8 @@ bool remove_function_pointers(
   const goto_functionst &goto_functions,
   goto_programt &goto_program,
   bool add_safety_assertion,
-  bool only_remove_const_fps=false);
+  bool only_remove_const_fps=false,
+  const function_pointer_targetst &function_pointer_targets=
+    function_pointer_targetst());
 
 #endif // CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
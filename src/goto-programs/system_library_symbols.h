@@ -13,6 +13,7 @@ Author: Thomas Kiley
 #define CPROVER_GOTO_PROGRAMS_SYSTEM_LIBRARY_SYMBOLS_H
 
 #include <list>
+#include <map>
 #include <set>
 #include <string>
 #include <util/irep.h>
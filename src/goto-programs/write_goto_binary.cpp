@@ -12,6 +12,8 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 #include <util/message.h>
 #include <util/irep_serialization.h>
@@ -19,15 +21,12 @@ Author: CM Wintersteiger
 
 #include <goto-programs/goto_model.h>
 
-/// Writes a goto program to disc, using goto binary format ver 2
-bool write_goto_binary_v3(
+/// Writes the symbol table part of a goto binary
+static void write_bin_symbols(
   std::ostream &out,
   const symbol_tablet &symbol_table,
-  const goto_functionst &goto_functions,
   irep_serializationt &irepconverter)
 {
-  // first write symbol table
-
   write_gb_word(out, symbol_table.symbols.size());
 
   forall_symbols(it, symbol_table.symbols)
@@ -70,6 +69,50 @@ bool write_goto_binary_v3(
 
     write_gb_word(out, flags);
   }
+}
+
+/// Writes the instructions of one function body
+static void write_bin_function_body(
+  std::ostream &out,
+  const goto_functionst::goto_functiont &function,
+  irep_serializationt &irepconverter)
+{
+  write_gb_word(out, function.body.instructions.size()); // # instructions
+
+  forall_goto_program_instructions(i_it, function.body)
+  {
+    const goto_programt::instructiont &instruction = *i_it;
+
+    irepconverter.reference_convert(instruction.code, out);
+    irepconverter.write_string_ref(out, instruction.function);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    irepconverter.write_string_ref(out, irep_idt()); // former event
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
+
+/// Writes a goto program to disc, using goto binary format ver 3
+bool write_goto_binary_v3(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions,
+  irep_serializationt &irepconverter)
+{
+  // first write symbol table
+
+  write_bin_symbols(out, symbol_table, irepconverter);
 
   // now write functions, but only those with body
 
@@ -88,35 +131,53 @@ bool write_goto_binary_v3(
       // instead they are saved in a custom binary format
 
       write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
+      write_bin_function_body(out, fct.second, irepconverter);
+    }
+  }
 
-      forall_goto_program_instructions(i_it, fct.second.body)
-      {
-        const goto_programt::instructiont &instruction = *i_it;
+  // irepconverter.output_map(f);
+  // irepconverter.output_string_map(f);
 
-        irepconverter.reference_convert(instruction.code, out);
-        irepconverter.write_string_ref(out, instruction.function);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        irepconverter.write_string_ref(out, irep_idt()); // former event
-        write_gb_word(out, instruction.target_number);
+  return false;
+}
 
-        write_gb_word(out, instruction.targets.size());
+/// Writes a goto program to disc, using goto binary format ver 4: the
+/// symbol table is followed by an index that gives the size of each
+/// function body, and each body is serialised with its own irep
+/// numbering so that it can be read without the others.
+bool write_goto_binary_v4(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions,
+  irep_serializationt &irepconverter)
+{
+  write_bin_symbols(out, symbol_table, irepconverter);
 
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
+  std::vector<std::pair<irep_idt, std::string> > bodies;
 
-        write_gb_word(out, instruction.labels.size());
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(fct.second.body_available())
+    {
+      std::ostringstream body_out;
+      irep_serializationt::ireps_containert ic;
+      irep_serializationt body_converter(ic);
+      write_bin_function_body(body_out, fct.second, body_converter);
 
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
-      }
+      bodies.push_back(std::make_pair(fct.first, body_out.str()));
     }
   }
 
-  // irepconverter.output_map(f);
-  // irepconverter.output_string_map(f);
+  write_gb_word(out, bodies.size());
+
+  for(const auto &body : bodies)
+  {
+    write_gb_string(out, id2string(body.first)); // name
+    write_gb_word(out, body.second.size()); // size in bytes
+  }
+
+  for(const auto &body : bodies)
+    out << body.second;
 
   return false;
 }
@@ -160,6 +221,10 @@ bool write_goto_binary(
     return write_goto_binary_v3(
       out, symbol_table, goto_functions, irepconverter);
 
+  case 4:
+    return write_goto_binary_v4(
+      out, symbol_table, goto_functions, irepconverter);
+
   default:
     throw "unknown goto binary version";
   }
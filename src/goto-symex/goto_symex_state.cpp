@@ -334,8 +334,7 @@ void goto_symex_statet::assignment(
   #endif
 
   // do the l2 renaming
-  if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-    level2.current_names[l1_identifier]=std::make_pair(lhs, 0);
+  level2.add(l1_identifier, lhs);
   level2.increase_counter(l1_identifier);
   set_ssa_indices(lhs, ns, L2);
 
@@ -374,14 +373,13 @@ void goto_symex_statet::assignment(
   #endif
 }
 
-void goto_symex_statet::propagationt::operator()(exprt &expr)
+void goto_symex_statet::propagationt::operator()(exprt &expr) const
 {
   if(expr.id()==ID_symbol)
   {
-    valuest::const_iterator it=
-      values.find(expr.get(ID_identifier));
-    if(it!=values.end())
-      expr=it->second;
+    const exprt *value=find(expr.get(ID_identifier));
+    if(value!=nullptr)
+      expr=*value;
   }
   else if(expr.id()==ID_address_of)
   {
@@ -464,11 +462,10 @@ void goto_symex_statet::rename(
       {
         // We also consider propagation if we go up to L2.
         // L1 identifiers are used for propagation!
-        propagationt::valuest::const_iterator p_it=
-          propagation.values.find(ssa.get_identifier());
+        const exprt *value=propagation.find(ssa.get_identifier());
 
-        if(p_it!=propagation.values.end())
-          expr=p_it->second; // already L2
+        if(value!=nullptr)
+          expr=*value; // already L2
         else
           set_ssa_indices(ssa, ns, L2);
       }
@@ -599,8 +596,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
 
     if(a_s_read.second.empty())
     {
-      if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-        level2.current_names[l1_identifier]=std::make_pair(ssa_l1, 0);
+      level2.add(l1_identifier, ssa_l1);
       level2.increase_counter(l1_identifier);
       a_s_read.first=level2.current_count(l1_identifier);
     }
@@ -637,8 +633,7 @@ bool goto_symex_statet::l2_thread_read_encoding(
     return true;
   }
 
-  if(level2.current_names.find(l1_identifier)==level2.current_names.end())
-    level2.current_names[l1_identifier]=std::make_pair(ssa_l1, 0);
+  level2.add(l1_identifier, ssa_l1);
 
   // No event and no fresh index, but avoid constant propagation
   if(!record_events)
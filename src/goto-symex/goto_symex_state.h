@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/std_expr.h>
 #include <util/ssa_expr.h>
 #include <util/make_unique.h>
+#include <util/sharing_map.h>
 
 #include <pointer-analysis/value_set.h>
 #include <goto-programs/goto_functions.h>
@@ -125,20 +126,70 @@ public:
   } level1;
 
   // level 2 -- SSA
+  // The names are kept in a sharing map, as each goto_statet takes a
+  // copy of them, and the copies only differ in what was assigned in
+  // the branches when they are merged again by phi_function.
 
-  struct level2t:public renaming_levelt
+  struct level2t
   {
-    level2t() { }
-    virtual ~level2t() { }
+    typedef sharing_mapt<
+      irep_idt, std::pair<ssa_exprt, unsigned>, irep_id_hash> current_namest;
+    current_namest current_names;
+
+    unsigned current_count(const irep_idt &identifier) const
+    {
+      current_namest::const_find_type entry=current_names.find(identifier);
+      return entry.second?entry.first.second:0;
+    }
+
+    void increase_counter(const irep_idt &identifier)
+    {
+      current_namest::find_type entry=current_names.find(identifier);
+      assert(entry.second);
+      ++entry.first.second;
+    }
+
+    void set_counter(const irep_idt &identifier, unsigned count)
+    {
+      current_namest::find_type entry=current_names.find(identifier);
+      assert(entry.second);
+      entry.first.second=count;
+    }
+
+    // adds the given name with counter 0, unless present
+    void add(const irep_idt &identifier, const ssa_exprt &ssa_expr)
+    {
+      current_names.insert(identifier, std::make_pair(ssa_expr, 0));
+    }
+
+    bool has(const irep_idt &identifier) const
+    {
+      return current_names.has_key(identifier);
+    }
+
+    void get_variables(std::unordered_set<ssa_exprt, irep_hash> &vars) const
+    {
+      current_namest::viewt view;
+      current_names.get_view(view);
+      for(const auto &item : view)
+        vars.insert(item.second.first);
+    }
   } level2;
 
   // this maps L1 names to (L2) constants
   class propagationt
   {
   public:
-    typedef std::map<irep_idt, exprt> valuest;
+    typedef sharing_mapt<irep_idt, exprt, irep_id_hash> valuest;
     valuest values;
-    void operator()(exprt &expr);
+    void operator()(exprt &expr) const;
+
+    // the value of the given L1 name, or nullptr if none
+    const exprt *find(const irep_idt &identifier) const
+    {
+      valuest::const_find_type entry=values.find(identifier);
+      return entry.second?&entry.first:nullptr;
+    }
 
     void remove(const irep_idt &identifier)
     {
@@ -212,18 +263,17 @@ public:
     void level2_get_variables(
       std::unordered_set<ssa_exprt, irep_hash> &vars) const
     {
-      for(level2t::current_namest::const_iterator
-          it=level2_current_names.begin();
-          it!=level2_current_names.end();
-          it++)
-        vars.insert(it->second.first);
+      level2t::current_namest::viewt view;
+      level2_current_names.get_view(view);
+      for(const auto &item : view)
+        vars.insert(item.second.first);
     }
 
     unsigned level2_current_count(const irep_idt &identifier) const
     {
-      level2t::current_namest::const_iterator it=
+      level2t::current_namest::const_find_type entry=
         level2_current_names.find(identifier);
-      return it==level2_current_names.end()?0:it->second.second;
+      return entry.second?entry.first.second:0;
     }
   };
 
@@ -342,7 +392,7 @@ public:
 
   void switch_to_thread(unsigned t);
   bool record_events;
-  std::unique_ptr<const dirtyt> dirty;
+  std::shared_ptr<const dirtyt> dirty;
 };
 
 #endif // CPROVER_GOTO_SYMEX_GOTO_SYMEX_STATE_H
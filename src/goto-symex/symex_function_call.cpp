@@ -335,25 +335,26 @@ void goto_symext::pop_frame(statet &state)
 
     // clear function-locals from L2 renaming
     PRECONDITION(state.dirty);
-    for(goto_symex_statet::renaming_levelt::current_namest::iterator
-        c_it=state.level2.current_names.begin();
-        c_it!=state.level2.current_names.end();
-       ) // no ++c_it
+    goto_symex_statet::level2t::current_namest::viewt view;
+    state.level2.current_names.get_view(view);
+
+    goto_symex_statet::level2t::current_namest::keyst locals;
+
+    for(const auto &item : view)
     {
-      const irep_idt l1_o_id=c_it->second.first.get_l1_object_identifier();
+      const irep_idt l1_o_id=item.second.first.get_l1_object_identifier();
       // could use iteration over local_objects as l1_o_id is prefix
       if(frame.local_objects.find(l1_o_id)==frame.local_objects.end() ||
          (state.threads.size()>1 &&
-          (*state.dirty)(c_it->second.first.get_object_name())))
-      {
-        ++c_it;
+          (*state.dirty)(item.second.first.get_object_name())))
         continue;
-      }
-      goto_symex_statet::renaming_levelt::current_namest::iterator
-        cur=c_it;
-      ++c_it;
-      state.level2.current_names.erase(cur);
+
+      locals.push_back(item.first);
     }
+
+    // the view refers to the map, hence erase once done with it
+    view.clear();
+    state.level2.current_names.erase_all(locals, tvt(true));
   }
 
   state.pop_frame();
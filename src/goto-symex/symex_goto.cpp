@@ -268,11 +268,28 @@ void goto_symext::phi_function(
   const statet::goto_statet &goto_state,
   statet &dest_state)
 {
-  // go over all variables to see what changed
-  std::unordered_set<ssa_exprt, irep_hash> variables;
+  // Go over the variables that may have changed. Both maps of names
+  // stem from the state at the branch, and hence only the names that
+  // were assigned in either branch don't share with the other map.
+  std::vector<ssa_exprt> variables;
 
-  goto_state.level2_get_variables(variables);
-  dest_state.level2.get_variables(variables);
+  {
+    statet::level2t::current_namest::delta_viewt delta_view;
+    goto_state.level2_current_names.get_delta_view(
+      dest_state.level2.current_names, delta_view, false);
+
+    for(const auto &delta_item : delta_view)
+      variables.push_back(delta_item.m.first);
+
+    // the names that are in the destination state only
+    delta_view.clear();
+    dest_state.level2.current_names.get_delta_view(
+      goto_state.level2_current_names, delta_view, false);
+
+    for(const auto &delta_item : delta_view)
+      if(!delta_item.in_both)
+        variables.push_back(delta_item.m.first);
+  }
 
   guardt diff_guard;
 
@@ -284,7 +301,7 @@ void goto_symext::phi_function(
     diff_guard-=dest_state.guard;
   }
 
-  for(std::unordered_set<ssa_exprt, irep_hash>::const_iterator
+  for(std::vector<ssa_exprt>::const_iterator
       it=variables.begin();
       it!=variables.end();
       it++)
@@ -322,22 +339,20 @@ void goto_symext::phi_function(
     exprt goto_state_rhs=*it, dest_state_rhs=*it;
 
     {
-      goto_symex_statet::propagationt::valuest::const_iterator p_it=
-        goto_state.propagation.values.find(l1_identifier);
+      const exprt *value=goto_state.propagation.find(l1_identifier);
 
-      if(p_it!=goto_state.propagation.values.end())
-        goto_state_rhs=p_it->second;
+      if(value!=nullptr)
+        goto_state_rhs=*value;
       else
         to_ssa_expr(goto_state_rhs).set_level_2(
           goto_state.level2_current_count(l1_identifier));
     }
 
     {
-      goto_symex_statet::propagationt::valuest::const_iterator p_it=
-        dest_state.propagation.values.find(l1_identifier);
+      const exprt *value=dest_state.propagation.find(l1_identifier);
 
-      if(p_it!=dest_state.propagation.values.end())
-        dest_state_rhs=p_it->second;
+      if(value!=nullptr)
+        dest_state_rhs=*value;
       else
         to_ssa_expr(dest_state_rhs).set_level_2(
           dest_state.level2.current_count(l1_identifier));
@@ -23,7 +23,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_symex_state.h"
 
 symex_target_equationt::symex_target_equationt(
-  const namespacet &_ns):ns(_ns)
+  const namespacet &_ns):ns(_ns), io_count(0)
 {
 }
 
@@ -557,8 +557,6 @@ void symex_target_equationt::convert_assertions(
 void symex_target_equationt::convert_io(
   decision_proceduret &dec_proc)
 {
-  std::size_t io_count=0;
-
   for(auto &step : SSA_steps)
     if(!step.ignore)
     {
@@ -583,6 +581,85 @@ void symex_target_equationt::convert_io(
     }
 }
 
+/// converts the steps from the given one onwards, for extending a formula
+/// that has been passed to an incremental solver already; the assertions
+/// are not asserted, their cond_literal is to be used as an assumption
+/// \par parameters: decision procedure, the first step not converted yet,
+///   and the conjunction of the assumptions before that step, which is
+///   updated to include the assumptions of the steps converted
+/// \return -
+void symex_target_equationt::convert_incremental(
+  prop_convt &prop_conv,
+  SSA_stepst::iterator first,
+  literalt &assumption)
+{
+  for(auto it=first; it!=SSA_steps.end(); ++it)
+  {
+    if(it->ignore)
+      it->guard_literal=const_literal(false);
+    else
+      it->guard_literal=prop_conv.convert(it->guard);
+  }
+
+  for(auto it=first; it!=SSA_steps.end(); ++it)
+  {
+    if(it->is_assume() || it->is_goto())
+    {
+      if(it->ignore)
+        it->cond_literal=const_literal(true);
+      else
+        it->cond_literal=prop_conv.convert(it->cond_expr);
+    }
+    else if(it->ignore)
+      continue;
+    else if(it->is_assignment() || it->is_constraint())
+      prop_conv.set_to_true(it->cond_expr);
+    else if(it->is_decl())
+      prop_conv.convert(it->cond_expr);
+  }
+
+  for(auto it=first; it!=SSA_steps.end(); ++it)
+  {
+    if(it->is_assert())
+    {
+      implies_exprt implication(
+        literal_exprt(assumption),
+        it->cond_expr);
+
+      it->cond_literal=prop_conv.convert(implication);
+    }
+    else if(it->is_assume())
+    {
+      assumption=prop_conv.convert(
+        and_exprt(literal_exprt(assumption), literal_exprt(it->cond_literal)));
+    }
+  }
+
+  for(auto it=first; it!=SSA_steps.end(); ++it)
+  {
+    if(it->ignore)
+      continue;
+
+    for(const auto &arg : it->io_args)
+    {
+      if(arg.is_constant() ||
+         arg.id()==ID_string_constant)
+        it->converted_io_args.push_back(arg);
+      else
+      {
+        symbol_exprt symbol;
+        symbol.type()=arg.type();
+        symbol.set_identifier("symex::io::"+std::to_string(io_count++));
+
+        equal_exprt eq(arg, symbol);
+        merge_irep(eq);
+
+        prop_conv.set_to(eq, true);
+        it->converted_io_args.push_back(symbol);
+      }
+    }
+  }
+}
 
 void symex_target_equationt::merge_ireps(SSA_stept &SSA_step)
 {
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <list>
 #include <iosfwd>
 
+#include <util/chunk_allocator.h>
 #include <util/merge_irep.h>
 
 #include <goto-programs/goto_program.h>
@@ -283,9 +284,16 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // The steps are allocated in chunks, which keeps consecutive steps
+  // adjacent in memory while iterators to the steps remain stable.
+  typedef std::list<SSA_stept, chunk_allocatort<SSA_stept>> SSA_stepst;
   SSA_stepst SSA_steps;
 
+  void convert_incremental(
+    prop_convt &prop_conv,
+    SSA_stepst::iterator first,
+    literalt &assumption);
+
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
     SSA_stepst::iterator it=SSA_steps.begin();
@@ -318,6 +326,9 @@ public:
 protected:
   const namespacet &ns;
 
+  // for naming the symbols introduced by convert_io
+  std::size_t io_count;
+
   // for enforcing sharing in the expressions stored
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
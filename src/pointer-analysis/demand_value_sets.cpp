@@ -0,0 +1,341 @@
+/*******************************************************************\
+
+Module: Demand-Driven Value Sets
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Demand-Driven Value Sets
+
+#include "demand_value_sets.h"
+
+#include <util/expr_iterator.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+
+#include "add_failed_symbols.h"
+
+void demand_value_setst::operator()(const goto_functionst &goto_functions)
+{
+  forall_goto_functions(f_it, goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      const codet &code=i_it->code;
+
+      switch(i_it->type)
+      {
+      case ASSIGN:
+        add_assignment(code.op0(), code.op1(), i_it->location_number);
+        break;
+
+      case DECL:
+      {
+        // as in value_sett::apply_code
+        const symbol_exprt &lhs=to_symbol_expr(to_code_decl(code).symbol());
+        const typet &lhs_type=ns.follow(lhs.type());
+
+        if(lhs_type.id()==ID_pointer ||
+           (lhs_type.id()==ID_array &&
+            ns.follow(lhs_type.subtype()).id()==ID_pointer))
+        {
+          exprt failed=get_failed_symbol(lhs, ns);
+
+          if(failed.is_not_nil())
+            add_assignment(
+              lhs,
+              address_of_exprt(failed, to_pointer_type(lhs.type())),
+              i_it->location_number);
+          else
+            add_assignment(lhs, exprt(ID_invalid), i_it->location_number);
+        }
+        break;
+      }
+
+      case RETURN:
+        if(code.operands().size()==1)
+        {
+          symbol_exprt lhs(
+            id2string(f_it->first)+"#return_value", code.op0().type());
+          add_assignment(lhs, code.op0(), i_it->location_number);
+        }
+        break;
+
+      case FUNCTION_CALL:
+        add_function_call(
+          to_code_function_call(code), goto_functions, i_it->location_number);
+        break;
+
+      default:
+        {
+        }
+      }
+    }
+  }
+}
+
+/// Assigns the arguments to the parameters of the callee, and its return
+/// value to the left-hand side. As in `value_set_analysist`, calls to
+/// functions without body, or through function pointers, do not change
+/// any values.
+void demand_value_setst::add_function_call(
+  const code_function_callt &code,
+  const goto_functionst &goto_functions,
+  unsigned location_number)
+{
+  if(code.function().id()!=ID_symbol)
+    return;
+
+  const irep_idt &function=to_symbol_expr(code.function()).get_identifier();
+
+  goto_functionst::function_mapt::const_iterator f_it=
+    goto_functions.function_map.find(function);
+
+  if(f_it==goto_functions.function_map.end() ||
+     !f_it->second.body_available())
+    return;
+
+  const code_typet &type=to_code_type(ns.lookup(function).type);
+  const code_typet::parameterst &parameters=type.parameters();
+  const exprt::operandst &arguments=code.arguments();
+
+  for(std::size_t i=0; i<parameters.size() && i<arguments.size(); i++)
+  {
+    const irep_idt &identifier=parameters[i].get_identifier();
+    if(identifier.empty())
+      continue;
+
+    add_assignment(
+      symbol_exprt(identifier, parameters[i].type()),
+      arguments[i],
+      location_number);
+  }
+
+  if(code.lhs().is_not_nil())
+    add_assignment(
+      code.lhs(),
+      symbol_exprt(id2string(function)+"#return_value", code.lhs().type()),
+      location_number);
+}
+
+void demand_value_setst::add_assignment(
+  const exprt &lhs,
+  const exprt &rhs,
+  unsigned location_number)
+{
+  std::size_t index=assignments.size();
+  assignments.push_back({lhs, rhs, location_number, false});
+
+  irep_idt object=root_object(lhs);
+
+  if(object.empty())
+    indirect_writes.push_back(index);
+  else
+    direct_writes[object].push_back(index);
+}
+
+/// \return the identifier of the object that \p expr is a part of,
+///   or the empty string if it does not name one
+irep_idt demand_value_setst::root_object(const exprt &expr)
+{
+  if(expr.id()==ID_symbol)
+    return to_symbol_expr(expr).get_identifier();
+  else if(expr.id()==ID_dynamic_object)
+    return "value_set::dynamic_object"+
+      std::to_string(to_dynamic_object_expr(expr).get_instance());
+  else if(expr.id()==ID_member ||
+          expr.id()==ID_index ||
+          expr.id()==ID_typecast ||
+          expr.id()==ID_byte_extract_little_endian ||
+          expr.id()==ID_byte_extract_big_endian)
+    return root_object(expr.op0());
+  else
+    return irep_idt();
+}
+
+/// \return true iff \p object was not demanded before
+bool demand_value_setst::demand(const irep_idt &object)
+{
+  if(!demanded.insert(object).second)
+    return false;
+
+  auto w_it=direct_writes.find(object);
+  if(w_it!=direct_writes.end())
+  {
+    for(const auto index : w_it->second)
+      activate(index);
+
+    // Reading an object without entry yields an unknown value. The
+    // assignments are applied in no particular order, but declarations
+    // and the initialization of static objects write to the objects
+    // before they are read, hence we create the entry up front.
+    const exprt *root=&assignments[w_it->second.front()].lhs;
+    while(root->id()!=ID_symbol)
+      root=&root->op0();
+
+    state.get_entry(value_sett::entryt(object, ""), root->type(), ns);
+  }
+
+  return true;
+}
+
+void demand_value_setst::activate(std::size_t index)
+{
+  if(!assignments[index].active)
+  {
+    assignments[index].active=true;
+    active.push_back(index);
+  }
+}
+
+/// Demands the objects whose values \p expr depends on, given the
+/// current values of the pointers it dereferences
+/// \return true iff an object was not demanded before
+bool demand_value_setst::demand_reads(const exprt &expr)
+{
+  bool result=false;
+
+  for(auto it=expr.depth_cbegin(); it!=expr.depth_cend(); ++it)
+  {
+    if(it->id()==ID_symbol)
+    {
+      if(demand(to_symbol_expr(*it).get_identifier()))
+        result=true;
+    }
+    else if(it->id()==ID_dereference)
+    {
+      valuest values;
+      state.get_value_set(it->op0(), values, ns);
+
+      for(const auto &value : values)
+      {
+        if(value.id()!=ID_object_descriptor)
+          continue;
+
+        irep_idt object=
+          root_object(to_object_descriptor_expr(value).object());
+
+        if(!object.empty() && demand(object))
+          result=true;
+      }
+    }
+  }
+
+  return result;
+}
+
+/// Demands the objects that the address of \p lhs depends on, but not
+/// those that \p lhs denotes
+/// \return true iff an object was not demanded before
+bool demand_value_setst::demand_address_reads(const exprt &lhs)
+{
+  if(lhs.id()==ID_symbol)
+    return false;
+  else if(lhs.id()==ID_member || lhs.id()==ID_typecast)
+    return demand_address_reads(lhs.op0());
+  else if(lhs.id()==ID_index)
+  {
+    bool result=demand_address_reads(lhs.op0());
+    if(demand_reads(lhs.op1()))
+      result=true;
+    return result;
+  }
+  else if(lhs.id()==ID_dereference)
+    return demand_reads(lhs.op0());
+  else
+    return demand_reads(lhs);
+}
+
+/// \return true iff an assignment to \p lhs may write to a demanded
+///   object, given the current values of the pointers it dereferences
+bool demand_value_setst::may_write_demanded(const exprt &lhs) const
+{
+  valuest references;
+  state.get_reference_set(lhs, references, ns);
+
+  // value_sett ignores writes to unknown objects
+  for(const auto &reference : references)
+  {
+    if(reference.id()!=ID_object_descriptor)
+      continue;
+
+    irep_idt object=
+      root_object(to_object_descriptor_expr(reference).object());
+
+    if(!object.empty() && demanded.find(object)!=demanded.end())
+      return true;
+  }
+
+  return false;
+}
+
+/// Applies the active assignments until neither the values nor the
+/// demanded objects change. As assignments only add values, the values
+/// of demanded objects are final once this returns.
+void demand_value_setst::solve()
+{
+  while(true)
+  {
+    bool changed=false;
+    const value_sett::valuest old_values=state.values;
+
+    // the targets of the pointers that writes go through decide which
+    // objects the writes change
+    for(const auto index : indirect_writes)
+    {
+      if(demand_address_reads(assignments[index].lhs))
+        changed=true;
+
+      if(!assignments[index].active &&
+         may_write_demanded(assignments[index].lhs))
+      {
+        activate(index);
+        changed=true;
+      }
+    }
+
+    // activating may add assignments as we go
+    for(std::size_t i=0; i<active.size(); i++)
+    {
+      const assignmentt &assignment=assignments[active[i]];
+
+      if(demand_address_reads(assignment.lhs))
+        changed=true;
+      if(demand_reads(assignment.rhs))
+        changed=true;
+
+      state.location_number=assignment.location_number;
+      state.assign(assignment.lhs, assignment.rhs, ns, false, true);
+    }
+
+    if(!changed && state.values==old_values)
+      return;
+  }
+}
+
+void demand_value_setst::get_values(
+  goto_programt::const_targett,
+  const exprt &expr,
+  valuest &dest)
+{
+  cachet::const_iterator c_it=cache.find(expr);
+
+  if(c_it==cache.end())
+  {
+    demand_reads(expr);
+    solve();
+
+    // the pointers that the expression dereferences may now have more
+    // targets
+    while(demand_reads(expr))
+      solve();
+
+    valuest values;
+    state.get_value_set(expr, values, ns);
+    c_it=cache.insert(std::make_pair(expr, values)).first;
+  }
+
+  dest.insert(dest.end(), c_it->second.begin(), c_it->second.end());
+}
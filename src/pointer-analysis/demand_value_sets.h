@@ -0,0 +1,116 @@
+/*******************************************************************\
+
+Module: Demand-Driven Value Sets
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Demand-Driven Value Sets
+
+#ifndef CPROVER_POINTER_ANALYSIS_DEMAND_VALUE_SETS_H
+#define CPROVER_POINTER_ANALYSIS_DEMAND_VALUE_SETS_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <util/irep_hash.h>
+#include <util/namespace.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include "value_set.h"
+#include "value_sets.h"
+
+/// Answers value-set queries without computing the values of all pointers
+/// at all locations first. The assignments of the program, including
+/// those of parameters and return values, are solved flow- and
+/// context-insensitively, with the transformers of `value_sett`, but only
+/// those that may write to an object the queries depend on, i.e., an
+/// object that is read by a query, by an assignment already taken into
+/// account, or through a pointer that such an expression dereferences.
+/// The solution is kept and extended by later queries, and the answers
+/// are cached.
+///
+/// Unlike `value_set_analysist`, the answers do not depend on the
+/// location of the query.
+class demand_value_setst:public value_setst
+{
+public:
+  explicit demand_value_setst(const namespacet &_ns):ns(_ns)
+  {
+  }
+
+  /// Collects the assignments of \p goto_functions; nothing is solved
+  /// before the first query
+  void operator()(const goto_functionst &goto_functions);
+
+  void get_values(
+    goto_programt::const_targett l,
+    const exprt &expr,
+    valuest &dest) override;
+
+  /// \return the number of assignments of the program
+  std::size_t number_of_assignments() const
+  {
+    return assignments.size();
+  }
+
+  /// \return the number of assignments the queries so far depend on
+  std::size_t number_of_active_assignments() const
+  {
+    return active.size();
+  }
+
+protected:
+  const namespacet &ns;
+
+  struct assignmentt
+  {
+    exprt lhs, rhs;
+    unsigned location_number;
+    bool active;
+  };
+
+  typedef std::vector<assignmentt> assignmentst;
+  assignmentst assignments;
+
+  /// the assignments to each object that is named on their left-hand side
+  std::unordered_map<irep_idt, std::vector<std::size_t>, irep_id_hash>
+    direct_writes;
+
+  /// the assignments to objects that are not named on their left-hand side
+  std::vector<std::size_t> indirect_writes;
+
+  std::unordered_set<irep_idt, irep_id_hash> demanded;
+  std::vector<std::size_t> active;
+
+  /// the values of the objects in `demanded`
+  value_sett state;
+
+  typedef std::unordered_map<exprt, valuest, irep_hash> cachet;
+  cachet cache;
+
+  void add_assignment(
+    const exprt &lhs,
+    const exprt &rhs,
+    unsigned location_number);
+
+  void add_function_call(
+    const code_function_callt &,
+    const goto_functionst &,
+    unsigned location_number);
+
+  static irep_idt root_object(const exprt &);
+
+  bool demand(const irep_idt &object);
+  bool demand_reads(const exprt &);
+  bool demand_address_reads(const exprt &lhs);
+  void activate(std::size_t);
+  bool may_write_demanded(const exprt &lhs) const;
+  void solve();
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_DEMAND_VALUE_SETS_H
@@ -0,0 +1,288 @@
+/*******************************************************************\
+
+Module: Value Set Object Maps
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Value Set Object Maps
+
+#include "object_offset_map.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <util/irep_hash.h>
+
+static bool key_less(
+  const object_offset_mapt::value_type &entry,
+  object_offset_mapt::key_type key)
+{
+  return entry.first<key;
+}
+
+object_offset_mapt::iterator object_offset_mapt::find(key_type key)
+{
+  iterator it=std::lower_bound(entries.begin(), entries.end(), key, key_less);
+  return it!=entries.end() && it->first==key?it:entries.end();
+}
+
+object_offset_mapt::const_iterator object_offset_mapt::find(
+  key_type key) const
+{
+  const_iterator it=
+    std::lower_bound(entries.begin(), entries.end(), key, key_less);
+  return it!=entries.end() && it->first==key?it:entries.end();
+}
+
+object_offset_mapt::offsett &object_offset_mapt::operator[](key_type key)
+{
+  return insert(value_type(key, offsett())).first->second;
+}
+
+object_offset_mapt::offsett &object_offset_mapt::at(key_type key)
+{
+  iterator it=find(key);
+  if(it==entries.end())
+    throw std::out_of_range("object_offset_mapt::at");
+  return it->second;
+}
+
+const object_offset_mapt::offsett &object_offset_mapt::at(key_type key) const
+{
+  const_iterator it=find(key);
+  if(it==entries.end())
+    throw std::out_of_range("object_offset_mapt::at");
+  return it->second;
+}
+
+std::pair<object_offset_mapt::iterator, bool> object_offset_mapt::insert(
+  const value_type &value)
+{
+  iterator it=
+    std::lower_bound(entries.begin(), entries.end(), value.first, key_less);
+
+  if(it!=entries.end() && it->first==value.first)
+    return std::make_pair(it, false);
+
+  it=entries.insert(it, value);
+
+  if(entries.size()==small_size+1)
+  {
+    // inserting may move the entries, but not change their order
+    std::size_t index=it-entries.begin();
+    rebuild_words();
+    it=entries.begin()+index;
+  }
+  else if(has_words())
+    set_word_bit(value.first);
+
+  return std::make_pair(it, true);
+}
+
+void object_offset_mapt::erase(key_type key)
+{
+  const_iterator it=find(key);
+  if(it!=entries.end())
+    erase(it);
+}
+
+object_offset_mapt::iterator object_offset_mapt::erase(const_iterator it)
+{
+  key_type key=it->first;
+  iterator result=entries.erase(it);
+
+  if(has_words())
+    clear_word_bit(key);
+  else
+    words.clear();
+
+  return result;
+}
+
+bool object_offset_mapt::make_union(const object_offset_mapt &src)
+{
+  if(subsumes(src))
+    return false;
+
+  entriest result;
+  result.reserve(entries.size()+src.entries.size());
+
+  const_iterator a=entries.begin(), b=src.entries.begin();
+
+  while(a!=entries.end() || b!=src.entries.end())
+  {
+    if(b==src.entries.end() || (a!=entries.end() && a->first<b->first))
+      result.push_back(*a++);
+    else if(a==entries.end() || b->first<a->first)
+      result.push_back(*b++);
+    else
+    {
+      if(a->second && b->second && *a->second==*b->second)
+        result.push_back(*a);
+      else
+        result.push_back(value_type(a->first, offsett()));
+      a++;
+      b++;
+    }
+  }
+
+  bool had_words=has_words();
+  entries.swap(result);
+
+  if(!has_words())
+    words.clear();
+  else if(!had_words)
+    rebuild_words();
+  else if(!src.has_words())
+  {
+    for(const auto &e : src.entries)
+      set_word_bit(e.first);
+  }
+  else
+  {
+    // or the words of both bitsets
+    wordst merged;
+    merged.reserve(words.size()+src.words.size());
+
+    wordst::const_iterator w=words.begin(), s=src.words.begin();
+
+    while(w!=words.end() || s!=src.words.end())
+    {
+      if(s==src.words.end() || (w!=words.end() && w->first<s->first))
+        merged.push_back(*w++);
+      else if(w==words.end() || s->first<w->first)
+        merged.push_back(*s++);
+      else
+      {
+        merged.push_back(std::make_pair(w->first, w->second|s->second));
+        w++;
+        s++;
+      }
+    }
+
+    words.swap(merged);
+  }
+
+  return true;
+}
+
+bool object_offset_mapt::subsumes(const object_offset_mapt &src) const
+{
+  if(src.entries.size()>entries.size())
+    return false;
+
+  if(src.has_words() && !words_subsume(src.words))
+    return false;
+
+  const_iterator d=entries.begin();
+
+  for(const auto &e : src.entries)
+  {
+    d=std::lower_bound(d, entries.end(), e.first, key_less);
+
+    if(d==entries.end() || d->first!=e.first)
+      return false;
+
+    // an unknown offset subsumes all others
+    if(d->second && (!e.second || *d->second!=*e.second))
+      return false;
+  }
+
+  return true;
+}
+
+std::size_t object_offset_mapt::hash() const
+{
+  std::size_t result=entries.size();
+
+  for(const auto &e : entries)
+  {
+    result=hash_combine(result, e.first);
+
+    if(!e.second)
+      result=hash_combine(result, 1);
+    else if(e.second->is_long())
+      result=hash_combine(result, e.second->to_long());
+  }
+
+  return result;
+}
+
+void object_offset_mapt::set_word_bit(key_type key)
+{
+  std::size_t index=key/word_bits;
+  wordt bit=wordt(1)<<(key%word_bits);
+
+  wordst::iterator it=std::lower_bound(
+    words.begin(),
+    words.end(),
+    index,
+    [](const std::pair<std::size_t, wordt> &w, std::size_t i)
+    {
+      return w.first<i;
+    });
+
+  if(it!=words.end() && it->first==index)
+    it->second|=bit;
+  else
+    words.insert(it, std::make_pair(index, bit));
+}
+
+void object_offset_mapt::clear_word_bit(key_type key)
+{
+  std::size_t index=key/word_bits;
+  wordt bit=wordt(1)<<(key%word_bits);
+
+  wordst::iterator it=std::lower_bound(
+    words.begin(),
+    words.end(),
+    index,
+    [](const std::pair<std::size_t, wordt> &w, std::size_t i)
+    {
+      return w.first<i;
+    });
+
+  if(it!=words.end() && it->first==index)
+  {
+    it->second&=~bit;
+    if(it->second==0)
+      words.erase(it);
+  }
+}
+
+void object_offset_mapt::rebuild_words()
+{
+  words.clear();
+
+  // the entries are sorted, and hence so are the words
+  for(const auto &e : entries)
+  {
+    std::size_t index=e.first/word_bits;
+    wordt bit=wordt(1)<<(e.first%word_bits);
+
+    if(!words.empty() && words.back().first==index)
+      words.back().second|=bit;
+    else
+      words.push_back(std::make_pair(index, bit));
+  }
+}
+
+/// \return true iff every bit of \p src is set in the bitset of this map
+bool object_offset_mapt::words_subsume(const wordst &src) const
+{
+  wordst::const_iterator w=words.begin();
+
+  for(const auto &s : src)
+  {
+    while(w!=words.end() && w->first<s.first)
+      w++;
+
+    if(w==words.end() || w->first!=s.first || (s.second & ~w->second)!=0)
+      return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,143 @@
+/*******************************************************************\
+
+Module: Value Set Object Maps
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Value Set Object Maps
+
+#ifndef CPROVER_POINTER_ANALYSIS_OBJECT_OFFSET_MAP_H
+#define CPROVER_POINTER_ANALYSIS_OBJECT_OFFSET_MAP_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <util/mp_arith.h>
+#include <util/optional.h>
+
+#include "object_numbering.h"
+
+/// A map from object numbers to the offsets into the objects, as stored
+/// in the right-hand sides of value sets. The entries are kept in a
+/// vector sorted by object number. Once a map holds more than
+/// `small_size` entries, it also keeps the set of its object numbers as
+/// a sparse bitset, which makes union and subset tests on the objects
+/// work a word at a time, and equality tests reject differing maps
+/// early.
+///
+/// As with `std::map`, the entries can be modified through iterators,
+/// but the object numbers must not be changed. References to the
+/// entries are invalidated by insertion and erasure.
+class object_offset_mapt
+{
+public:
+  typedef object_numberingt::number_type key_type;
+  typedef optionalt<mp_integer> offsett;
+  typedef std::pair<key_type, offsett> value_type;
+
+protected:
+  typedef std::vector<value_type> entriest;
+
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef entriest::iterator iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef entriest::const_iterator const_iterator;
+
+  /// Maps with up to this many entries have no bitset
+  static const std::size_t small_size=16;
+
+  iterator begin() { return entries.begin(); }
+  const_iterator begin() const { return entries.begin(); }
+  const_iterator cbegin() const { return entries.cbegin(); }
+
+  iterator end() { return entries.end(); }
+  const_iterator end() const { return entries.end(); }
+  const_iterator cend() const { return entries.cend(); }
+
+  std::size_t size() const { return entries.size(); }
+  bool empty() const { return entries.empty(); }
+
+  void clear()
+  {
+    entries.clear();
+    words.clear();
+  }
+
+  iterator find(key_type key);
+  const_iterator find(key_type key) const;
+
+  std::size_t count(key_type key) const
+  {
+    return find(key)!=end()?1:0;
+  }
+
+  /// Inserts an entry with unknown offset if there is none for \p key
+  offsett &operator[](key_type key);
+
+  offsett &at(key_type key);
+  const offsett &at(key_type key) const;
+
+  std::pair<iterator, bool> insert(const value_type &);
+
+  template<typename It>
+  void insert(It b, It e)
+  {
+    for(; b!=e; ++b)
+      insert(*b);
+  }
+
+  void erase(key_type key);
+  iterator erase(const_iterator it);
+
+  /// Adds the entries of \p src, where an object in both maps keeps its
+  /// offset only if the offsets are equal, and otherwise gets an unknown
+  /// offset
+  /// \return true iff the map has changed
+  bool make_union(const object_offset_mapt &src);
+
+  /// \return true iff `make_union(src)` would not change the map
+  bool subsumes(const object_offset_mapt &src) const;
+
+  std::size_t hash() const;
+
+  bool operator==(const object_offset_mapt &other) const
+  {
+    return entries.size()==other.entries.size() &&
+           words==other.words &&
+           entries==other.entries;
+  }
+
+  bool operator!=(const object_offset_mapt &other) const
+  {
+    return !(*this==other);
+  }
+
+protected:
+  entriest entries;
+
+  typedef std::uint64_t wordt;
+  static const std::size_t word_bits=64;
+
+  /// The non-zero words of the bitset of the object numbers, sorted by
+  /// their index; empty for small maps
+  typedef std::vector<std::pair<std::size_t, wordt>> wordst;
+  wordst words;
+
+  bool has_words() const
+  {
+    return entries.size()>small_size;
+  }
+
+  void set_word_bit(key_type key);
+  void clear_word_bit(key_type key);
+  void rebuild_words();
+
+  bool words_subsume(const wordst &src) const;
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_OBJECT_OFFSET_MAP_H
@@ -0,0 +1,537 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#include "steensgaard.h"
+
+#include <limits>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_expr.h>
+
+#include "add_failed_symbols.h"
+
+const steensgaard_analysist::size_type steensgaard_analysist::no_node=
+  std::numeric_limits<size_type>::max();
+
+steensgaard_analysist::steensgaard_analysist(const namespacet &_ns):
+  ns(_ns),
+  solved(false),
+  location_number(0)
+{
+}
+
+void steensgaard_analysist::operator()(const goto_functionst &goto_functions)
+{
+  forall_goto_functions(f_it, goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      const codet &code=i_it->code;
+      location_number=i_it->location_number;
+
+      switch(i_it->type)
+      {
+      case ASSIGN:
+        assign(code.op0(), code.op1());
+        break;
+
+      case DECL:
+      {
+        // as in value_sett::apply_code
+        const symbol_exprt &lhs=to_symbol_expr(to_code_decl(code).symbol());
+        exprt failed=get_failed_symbol(lhs, ns);
+
+        if(failed.is_not_nil())
+          assign(lhs, address_of_exprt(failed));
+        else
+          assign(lhs, exprt(ID_invalid));
+        break;
+      }
+
+      case RETURN:
+        if(code.operands().size()==1)
+          assign(
+            symbol_exprt(
+              id2string(f_it->first)+"#return_value", code.op0().type()),
+            code.op0());
+        break;
+
+      case FUNCTION_CALL:
+      {
+        const code_function_callt &call=to_code_function_call(code);
+
+        if(call.function().id()==ID_symbol)
+          do_function_call(
+            call,
+            to_symbol_expr(call.function()).get_identifier(),
+            goto_functions);
+        else if(call.function().id()==ID_dereference)
+        {
+          nodest callees;
+          locations(call.function(), callees);
+
+          if(callees.empty())
+            break;
+
+          for(const auto callee : callees)
+            join(callees.front(), callee);
+
+          indirect_calls.push_back({call, callees.front(), 0, {}});
+        }
+        break;
+      }
+
+      default:
+        {
+        }
+      }
+    }
+  }
+
+  do_indirect_calls(goto_functions);
+
+  solved=true;
+}
+
+/// Assigns the arguments to the parameters of \p function, and its return
+/// value to the left-hand side. As in `value_set_analysist`, calls to
+/// functions without body do not change any values.
+void steensgaard_analysist::do_function_call(
+  const code_function_callt &code,
+  const irep_idt &function,
+  const goto_functionst &goto_functions)
+{
+  goto_functionst::function_mapt::const_iterator f_it=
+    goto_functions.function_map.find(function);
+
+  if(f_it==goto_functions.function_map.end() ||
+     !f_it->second.body_available())
+    return;
+
+  const code_typet::parameterst &parameters=f_it->second.type.parameters();
+  const exprt::operandst &arguments=code.arguments();
+
+  for(std::size_t i=0; i<parameters.size() && i<arguments.size(); i++)
+  {
+    const irep_idt &identifier=parameters[i].get_identifier();
+    if(identifier.empty())
+      continue;
+
+    assign(symbol_exprt(identifier, parameters[i].type()), arguments[i]);
+  }
+
+  if(code.lhs().is_not_nil())
+    assign(
+      code.lhs(),
+      symbol_exprt(id2string(function)+"#return_value", code.lhs().type()));
+}
+
+/// Binds the calls through function pointers to the functions in the class
+/// that the pointer points to. Binding merges further classes, hence this
+/// is repeated until no call has a new target.
+void steensgaard_analysist::do_indirect_calls(
+  const goto_functionst &goto_functions)
+{
+  bool changed=true;
+
+  while(changed)
+  {
+    changed=false;
+
+    for(auto &call : indirect_calls)
+    {
+      // classes only grow, hence there is nothing new if the size is the same
+      std::size_t count=classes.count(call.pointer);
+      if(count==call.seen)
+        continue;
+      call.seen=count;
+
+      // binding may merge the class
+      const nodest callees=members[classes.find(call.pointer)];
+
+      for(const auto callee : callees)
+      {
+        const exprt &object=objects[callee];
+
+        if(object.id()==ID_symbol &&
+           object.type().id()==ID_code &&
+           call.bound.insert(to_symbol_expr(object).get_identifier()).second)
+        {
+          do_function_call(
+            call.code, to_symbol_expr(object).get_identifier(), goto_functions);
+          changed=true;
+        }
+      }
+    }
+  }
+}
+
+steensgaard_analysist::size_type steensgaard_analysist::new_node()
+{
+  size_type node=classes.size();
+  classes.resize(node+1);
+  pointees.push_back(no_node);
+  flags.push_back(0);
+  members.push_back(nodest());
+  objects.push_back(nil_exprt());
+  return node;
+}
+
+/// \return a node whose class has \p flag: a fresh one while solving,
+///   which keeps the classes of unrelated pointers apart, and a shared one
+///   once solved
+steensgaard_analysist::size_type steensgaard_analysist::flagged_node(
+  unsigned flag)
+{
+  if(solved)
+  {
+    std::map<unsigned, size_type>::const_iterator f_it=
+      flagged_nodes.find(flag);
+    if(f_it!=flagged_nodes.end())
+      return f_it->second;
+  }
+
+  size_type node=new_node();
+  flags[node]=flag;
+
+  if(solved)
+    flagged_nodes[flag]=node;
+
+  return node;
+}
+
+/// \return the node of the location of \p object, or `no_node` if there
+///   is none and the analysis is solved
+steensgaard_analysist::size_type steensgaard_analysist::location(
+  const exprt &object)
+{
+  // the type of a symbol may differ between its uses
+  exprt key=object;
+  if(object.id()==ID_symbol)
+  {
+    key=exprt(ID_symbol);
+    key.set(ID_identifier, to_symbol_expr(object).get_identifier());
+  }
+
+  location_mapt::const_iterator l_it=location_map.find(key);
+  if(l_it!=location_map.end())
+    return l_it->second;
+
+  if(solved)
+    return no_node;
+
+  size_type node=new_node();
+  objects[node]=object;
+  members[node].push_back(node);
+  location_map.insert(std::make_pair(key, node));
+  return node;
+}
+
+/// \return the class that the locations in the class of \p node point to,
+///   which is created unless the analysis is solved
+steensgaard_analysist::size_type steensgaard_analysist::pointee(
+  size_type node)
+{
+  if(node==no_node)
+    return no_node;
+
+  size_type root=classes.find(node);
+
+  if(pointees[root]==no_node)
+  {
+    if(solved)
+      return no_node;
+
+    size_type fresh=new_node();
+    pointees[root]=fresh;
+  }
+
+  return classes.find(pointees[root]);
+}
+
+/// Merges the classes of \p a and \p b, and, recursively, the classes that
+/// they point to
+void steensgaard_analysist::join(size_type a, size_type b)
+{
+  std::vector<std::pair<size_type, size_type>> worklist;
+  worklist.push_back(std::make_pair(a, b));
+
+  while(!worklist.empty())
+  {
+    a=classes.find(worklist.back().first);
+    b=classes.find(worklist.back().second);
+    worklist.pop_back();
+
+    if(a==b)
+      continue;
+
+    size_type pointee_a=pointees[a], pointee_b=pointees[b];
+
+    classes.make_union(a, b);
+    size_type root=classes.find(a);
+    size_type other=root==a?b:a;
+
+    flags[root]|=flags[other];
+
+    // move the smaller list of members
+    if(members[root].size()<members[other].size())
+      members[root].swap(members[other]);
+    members[root].insert(
+      members[root].end(), members[other].begin(), members[other].end());
+    nodest().swap(members[other]);
+
+    if(pointee_a==no_node)
+      pointees[root]=pointee_b;
+    else
+    {
+      pointees[root]=pointee_a;
+      if(pointee_b!=no_node)
+        worklist.push_back(std::make_pair(pointee_a, pointee_b));
+    }
+  }
+}
+
+/// Adds to \p dest the classes of the locations that \p lvalue may denote
+void steensgaard_analysist::locations(const exprt &lvalue, nodest &dest)
+{
+  if(lvalue.id()==ID_member ||
+     lvalue.id()==ID_index ||
+     lvalue.id()==ID_typecast ||
+     lvalue.id()==ID_byte_extract_little_endian ||
+     lvalue.id()==ID_byte_extract_big_endian)
+  {
+    // field-insensitive
+    locations(lvalue.op0(), dest);
+  }
+  else if(lvalue.id()==ID_if)
+  {
+    locations(to_if_expr(lvalue).true_case(), dest);
+    locations(to_if_expr(lvalue).false_case(), dest);
+  }
+  else if(lvalue.id()==ID_dereference)
+    points_to(to_dereference_expr(lvalue).pointer(), dest);
+  else
+  {
+    // symbols, string constants and the like
+    size_type node=location(lvalue);
+    if(node!=no_node)
+      dest.push_back(node);
+  }
+}
+
+/// Adds to \p dest the classes of the locations that the value of \p expr
+/// may point to
+void steensgaard_analysist::points_to(const exprt &expr, nodest &dest)
+{
+  if(expr.id()==ID_symbol ||
+     expr.id()==ID_member ||
+     expr.id()==ID_index ||
+     expr.id()==ID_dereference ||
+     expr.id()==ID_byte_extract_little_endian ||
+     expr.id()==ID_byte_extract_big_endian)
+  {
+    nodest nodes;
+    locations(expr, nodes);
+
+    for(const auto node : nodes)
+    {
+      size_type p=pointee(node);
+      if(p!=no_node)
+        dest.push_back(p);
+    }
+  }
+  else if(expr.id()==ID_address_of)
+    locations(to_address_of_expr(expr).object(), dest);
+  else if(expr.id()==ID_side_effect)
+  {
+    const irep_idt &statement=expr.get(ID_statement);
+
+    // one dynamic object per allocation site, as in value_sett
+    if(statement==ID_allocate ||
+       statement==ID_cpp_new ||
+       statement==ID_cpp_new_array)
+    {
+      const typet &dynamic_type=
+        statement==ID_allocate?
+        static_cast<const typet &>(expr.find(ID_C_cxx_alloc_type)):
+        expr.type().subtype();
+
+      dynamic_object_exprt dynamic_object(dynamic_type);
+      dynamic_object.set_instance(location_number);
+      dynamic_object.valid()=true_exprt();
+
+      size_type node=location(dynamic_object);
+      if(node!=no_node)
+        dest.push_back(node);
+    }
+    else
+      dest.push_back(flagged_node(UNKNOWN));
+  }
+  else if(expr.id()==ID_unknown)
+    dest.push_back(flagged_node(UNKNOWN));
+  else if(expr.id()==ID_invalid)
+    dest.push_back(flagged_node(INVALID));
+  else if(expr.is_constant())
+  {
+    // as in value_sett
+    if(expr.type().id()==ID_pointer)
+      dest.push_back(
+        flagged_node(
+          expr.get(ID_value)==ID_NULL?NULL_OBJECT:INTEGER_ADDRESS));
+  }
+  else if(expr.id()==ID_typecast &&
+          expr.type().id()==ID_pointer &&
+          (ns.follow(expr.op0().type()).id()==ID_signedbv ||
+           ns.follow(expr.op0().type()).id()==ID_unsignedbv))
+  {
+    // integer-to-pointer
+    if(expr.op0().is_zero())
+      dest.push_back(flagged_node(NULL_OBJECT));
+    else
+    {
+      nodest nodes;
+      points_to(expr.op0(), nodes);
+
+      if(nodes.empty())
+        dest.push_back(flagged_node(INTEGER_ADDRESS));
+      else
+        dest.insert(dest.end(), nodes.begin(), nodes.end());
+    }
+  }
+  else if(expr.id()==ID_if)
+  {
+    points_to(to_if_expr(expr).true_case(), dest);
+    points_to(to_if_expr(expr).false_case(), dest);
+  }
+  else if(expr.type().id()!=ID_bool)
+  {
+    // pointer arithmetic, casts, struct constructors and the like
+    forall_operands(it, expr)
+      points_to(*it, dest);
+  }
+}
+
+void steensgaard_analysist::assign(const exprt &lhs, const exprt &rhs)
+{
+  nodest values;
+  points_to(rhs, values);
+
+  if(values.empty())
+    return;
+
+  for(const auto value : values)
+    join(values.front(), value);
+
+  nodest lhs_locations;
+  locations(lhs, lhs_locations);
+
+  for(const auto node : lhs_locations)
+    join(pointee(node), values.front());
+}
+
+void steensgaard_analysist::get_values(
+  goto_programt::const_targett,
+  const exprt &expr,
+  valuest &dest)
+{
+  nodest nodes;
+  points_to(expr, nodes);
+
+  std::set<size_type> roots;
+  for(const auto node : nodes)
+    roots.insert(classes.find(node));
+
+  const std::size_t size=dest.size();
+
+  for(const auto root : roots)
+  {
+    // value_sett reads an uninitialised pointer as unknown, too
+    if(flags[root]&(UNKNOWN|INVALID))
+      dest.push_back(exprt(ID_unknown, expr.type()));
+
+    if(flags[root]&NULL_OBJECT)
+    {
+      object_descriptor_exprt od;
+      od.object()=exprt(
+        "NULL-object",
+        expr.type().id()==ID_pointer?expr.type().subtype():empty_typet());
+      od.offset()=from_integer(0, index_type());
+      od.type()=od.object().type();
+      dest.push_back(od);
+    }
+
+    if(flags[root]&INTEGER_ADDRESS)
+    {
+      object_descriptor_exprt od;
+      od.object()=exprt(ID_integer_address, unsigned_char_type());
+      od.type()=od.object().type();
+      dest.push_back(od);
+    }
+
+    // the offsets are not tracked
+    for(const auto member : members[root])
+    {
+      object_descriptor_exprt od;
+      od.object()=objects[member];
+      od.type()=od.object().type();
+      dest.push_back(od);
+    }
+  }
+
+  // nothing was assigned, e.g., the return value of a function without
+  // body; value_sett has no entry for these either
+  if(dest.size()==size)
+    dest.push_back(exprt(ID_unknown, expr.type()));
+}
+
+bool steensgaard_analysist::get_function_targets(
+  const exprt &pointer,
+  std::set<irep_idt> &dest)
+{
+  nodest nodes;
+  points_to(pointer, nodes);
+
+  std::size_t size=dest.size();
+
+  for(const auto node : nodes)
+  {
+    size_type root=classes.find(node);
+
+    // an uninitialised pointer cannot be called through without undefined
+    // behaviour, which leaves the functions assigned to it as targets
+    if(flags[root]&(UNKNOWN|INTEGER_ADDRESS))
+      return false;
+
+    for(const auto member : members[root])
+    {
+      if(objects[member].id()==ID_symbol &&
+         objects[member].type().id()==ID_code)
+        dest.insert(to_symbol_expr(objects[member]).get_identifier());
+    }
+  }
+
+  // e.g., a parameter of the entry point, or a pointer copied with memcpy
+  return dest.size()>size;
+}
+
+std::size_t steensgaard_analysist::number_of_classes() const
+{
+  std::size_t result=0;
+
+  for(size_type node=0; node<classes.size(); node++)
+  {
+    if(classes.is_root(node) && !members[node].empty())
+      result++;
+  }
+
+  return result;
+}
@@ -0,0 +1,136 @@
+/*******************************************************************\
+
+Module: Unification-Based Points-To Analysis
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Unification-Based Points-To Analysis
+
+#ifndef CPROVER_POINTER_ANALYSIS_STEENSGAARD_H
+#define CPROVER_POINTER_ANALYSIS_STEENSGAARD_H
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include <util/irep_hash.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/union_find.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include "value_sets.h"
+
+/// Steensgaard's points-to analysis: the abstract locations, i.e., the
+/// objects of the program, dynamic objects per allocation site included,
+/// are partitioned into equivalence classes, and all locations of a class
+/// point to the same class. An assignment merges the class that its
+/// right-hand side points to with the one its left-hand side points to,
+/// which takes near-linear time in the size of the program overall.
+///
+/// The analysis is flow-, context- and field-insensitive, and a class is
+/// never split again, which makes its answers far coarser than those of
+/// `value_set_analysist`, but it scales to programs the latter does not
+/// finish on. Calls through function pointers are bound to the functions
+/// in the class that the pointer points to, until no new targets arise.
+///
+/// A class also records whether its pointers may be NULL, integer
+/// addresses, unknown or uninitialised, which `get_values` reports as
+/// `value_sett` does. Since the analysis is flow-insensitive, the latter
+/// holds for every pointer declared without a failed symbol, and
+/// `get_function_targets` hence ignores it.
+class steensgaard_analysist:public value_setst
+{
+public:
+  typedef unsigned_union_find::size_type size_type;
+
+  explicit steensgaard_analysist(const namespacet &_ns);
+
+  void operator()(const goto_functionst &goto_functions);
+
+  void get_values(
+    goto_programt::const_targett l,
+    const exprt &expr,
+    valuest &dest) override;
+
+  /// Adds to \p dest the functions that \p pointer may point to
+  /// \return false iff the targets of \p pointer are not known, which
+  ///   includes pointers that the analysis found no function for
+  bool get_function_targets(const exprt &pointer, std::set<irep_idt> &dest);
+
+  /// \return the number of equivalence classes of locations
+  std::size_t number_of_classes() const;
+
+protected:
+  const namespacet &ns;
+
+  static const size_type no_node;
+
+  unsigned_union_find classes;
+
+  /// what a class may contain besides the objects of its members
+  enum flagt
+  {
+    UNKNOWN=1,
+    NULL_OBJECT=2,
+    INTEGER_ADDRESS=4,
+    INVALID=8
+  };
+
+  // the following are meaningful for the roots of the classes only
+  std::vector<size_type> pointees;
+  std::vector<unsigned> flags;
+  std::vector<std::vector<size_type>> members;
+
+  /// the object of each node that is a location, and nil otherwise
+  std::vector<exprt> objects;
+
+  typedef std::unordered_map<exprt, size_type, irep_hash> location_mapt;
+  location_mapt location_map;
+
+  /// the nodes that queries use for the flags once solved
+  std::map<unsigned, size_type> flagged_nodes;
+
+  /// Once set, queries must not change the classes
+  bool solved;
+
+  unsigned location_number;
+
+  struct indirect_callt
+  {
+    code_function_callt code;
+    size_type pointer;
+    /// the size of the class of `pointer` when last bound
+    std::size_t seen;
+    std::set<irep_idt> bound;
+  };
+
+  std::vector<indirect_callt> indirect_calls;
+
+  typedef std::vector<size_type> nodest;
+
+  size_type new_node();
+  size_type flagged_node(unsigned flag);
+  size_type location(const exprt &object);
+  size_type pointee(size_type node);
+  void join(size_type a, size_type b);
+
+  void locations(const exprt &lvalue, nodest &dest);
+  void points_to(const exprt &expr, nodest &dest);
+
+  void assign(const exprt &lhs, const exprt &rhs);
+
+  void do_function_call(
+    const code_function_callt &code,
+    const irep_idt &function,
+    const goto_functionst &goto_functions);
+
+  void do_indirect_calls(const goto_functionst &goto_functions);
+};
+
+#endif // CPROVER_POINTER_ANALYSIS_STEENSGAARD_H
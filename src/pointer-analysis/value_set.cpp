@@ -11,8 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "value_set.h"
 
+#include <algorithm>
 #include <cassert>
 #include <ostream>
+#include <unordered_map>
 
 #include <util/symbol_table.h>
 #include <util/simplify_expr.h>
@@ -236,7 +238,10 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
     const entryt &new_e=it->second;
 
     if(make_union(e.object_map, new_e.object_map))
+    {
+      share(e.object_map);
       result=true;
+    }
 
     v_it++;
     it++;
@@ -247,17 +252,62 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
 
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  if(dest.get_d()==src.get_d() || src.read().empty())
+    return false;
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    dest=src;
+    return true;
   }
 
-  return result;
+  // avoid copying a shared map that would not change
+  if(dest.read().subsumes(src.read()))
+    return false;
+
+  return dest.write().make_union(src.read());
+}
+
+void value_sett::share(object_mapt &object_map)
+{
+  typedef std::unordered_multimap<std::size_t, object_mapt> tablet;
+
+  // Never destroyed, as value sets with static storage duration may be
+  // destroyed after any other static object.
+  static tablet &table=*new tablet();
+  static std::size_t prune_size=1024;
+
+  if(object_map.read().empty())
+    return;
+
+  std::size_t hash=object_map.read().hash();
+
+  auto range=table.equal_range(hash);
+  for(auto it=range.first; it!=range.second; it++)
+  {
+    if(it->second.read()==object_map.read())
+    {
+      if(it->second.get_d()!=object_map.get_d())
+        object_map=it->second;
+      return;
+    }
+  }
+
+  table.insert(std::make_pair(hash, object_map));
+
+  if(table.size()>=prune_size)
+  {
+    // forget the maps that only the table refers to
+    for(auto it=table.begin(); it!=table.end(); )
+    {
+      if(it->second.get_d()->ref_count==1)
+        it=table.erase(it);
+      else
+        it++;
+    }
+
+    prune_size=std::max(prune_size, 2*table.size());
+  }
 }
 
 bool value_sett::eval_pointer_offset(
@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/reference_counting.h>
 
 #include "object_numbering.h"
+#include "object_offset_map.h"
 #include "value_sets.h"
 
 class namespacet;
@@ -72,70 +73,15 @@ public:
   /// offsets (`offsett` instances). This is the RHS set of a single row of
   /// the enclosing `value_sett`, such as `{ null, dynamic_object1 }`.
   /// The set is represented as a map from numbered `exprt`s to `offsett`
-  /// instead of a set of pairs to make lookup by `exprt` easier. All
-  /// methods matching the interface of `std::map` forward those methods
-  /// to the internal map.
-  class object_map_dt
+  /// instead of a set of pairs to make lookup by `exprt` easier; see
+  /// `object_offset_mapt` for the interface, which follows `std::map`.
+  class object_map_dt:public object_offset_mapt
   {
-    typedef std::map<object_numberingt::number_type, offsett> data_typet;
-    data_typet data;
-
   public:
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::iterator iterator;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::const_iterator const_iterator;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::value_type value_type;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::key_type key_type;
-
-    iterator begin() { return data.begin(); }
-    const_iterator begin() const { return data.begin(); }
-    const_iterator cbegin() const { return data.cbegin(); }
-
-    iterator end() { return data.end(); }
-    const_iterator end() const { return data.end(); }
-    const_iterator cend() const { return data.cend(); }
-
-    size_t size() const { return data.size(); }
-    bool empty() const { return data.empty(); }
-
-    void erase(key_type i) { data.erase(i); }
-    void erase(const_iterator it) { data.erase(it); }
-
-    offsett &operator[](key_type i)
-    {
-      return data[i];
-    }
-    offsett &at(key_type i)
-    {
-      return data.at(i);
-    }
-    const offsett &at(key_type i) const
-    {
-      return data.at(i);
-    }
-
-    template <typename It>
-    void insert(It b, It e) { data.insert(b, e); }
-
-    template <typename T>
-    const_iterator find(T &&t) const { return data.find(std::forward<T>(t)); }
-
     static const object_map_dt blank;
 
     object_map_dt()=default;
 
-    bool operator==(const object_map_dt &other) const
-    {
-      return data==other.data;
-    }
-    bool operator!=(const object_map_dt &other) const
-    {
-      return !(*this==other);
-    }
-
   protected:
     ~object_map_dt()=default;
   };
@@ -351,6 +297,11 @@ public:
   /// \return true if anything changed.
   bool make_union(const valuest &new_values);
 
+  /// Makes \p object_map share its data with an equal object map that was
+  /// shared before, if any, such that equal RHS expression sets produced
+  /// by merges at different instructions are stored once
+  static void share(object_mapt &object_map);
+
   /// Merges an entire existing value_sett's data into this one
   /// \return true if anything changed.
   bool make_union(const value_sett &new_values)
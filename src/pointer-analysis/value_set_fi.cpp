@@ -283,15 +283,20 @@ bool value_set_fit::make_union(const value_set_fit::valuest &new_values)
 
 bool value_set_fit::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  if(dest.get_d()==src.get_d() || src.read().empty())
+    return false;
 
-  forall_objects(it, src.read())
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    dest=src;
+    return true;
   }
 
-  return result;
+  // avoid copying a shared map that would not change
+  if(dest.read().subsumes(src.read()))
+    return false;
+
+  return dest.write().make_union(src.read());
 }
 
 void value_set_fit::get_value_set(
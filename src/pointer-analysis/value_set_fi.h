@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/reference_counting.h>
 
 #include "object_numbering.h"
+#include "object_offset_map.h"
 
 class value_set_fit
 {
@@ -60,42 +61,13 @@ public:
     return offset && offset->is_zero();
   }
 
-  class object_map_dt
+  class object_map_dt:public object_offset_mapt
   {
-    typedef std::map<object_numberingt::number_type, offsett> data_typet;
-    data_typet data;
-
   public:
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::iterator iterator;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::const_iterator const_iterator;
-    // NOLINTNEXTLINE(readability/identifiers)
-    typedef data_typet::value_type value_type;
-
-    iterator begin() { return data.begin(); }
-    const_iterator begin() const { return data.begin(); }
-    const_iterator cbegin() const { return data.cbegin(); }
-
-    iterator end() { return data.end(); }
-    const_iterator end() const { return data.end(); }
-    const_iterator cend() const { return data.cend(); }
-
-    size_t size() const { return data.size(); }
-
-    offsett &operator[](object_numberingt::number_type i)
-    {
-      return data[i];
-    }
-
-    template <typename It>
-    void insert(It b, It e) { data.insert(b, e); }
-
-    template <typename T>
-    const_iterator find(T &&t) const { return data.find(std::forward<T>(t)); }
-
     static const object_map_dt blank;
 
+    object_map_dt()=default;
+
   protected:
     ~object_map_dt()=default;
   };
@@ -24,6 +24,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/invariant.h>
 
 #include "object_numbering.h"
+#include "object_offset_map.h"
 
 class value_set_fivrnst
 {
@@ -65,7 +66,7 @@ public:
     object_map_dt() {}
     static const object_map_dt blank;
 
-    typedef std::map<object_numberingt::number_type, offsett> objmapt;
+    typedef object_offset_mapt objmapt;
     objmapt objmap;
 
     // NOLINTNEXTLINE(readability/identifiers)
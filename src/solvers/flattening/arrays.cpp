@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/base_type.h>
 #include <util/namespace.h>
 
+#include <solvers/prop/literal_expr.h>
 #include <solvers/prop/prop.h>
 
 #ifdef DEBUG
@@ -28,6 +29,7 @@ arrayst::arrayst(
 {
   lazy_arrays = false;        // will be set to true when --refine is used
   incremental_cache = false;  // for incremental solving
+  array_lemmas_on_demand = false;
 }
 
 void arrayst::record_array_index(const index_exprt &index)
@@ -258,8 +260,94 @@ void arrayst::add_array_constraint(const lazy_constraintt &lazy, bool refine)
   }
 }
 
+/// records the constraint that guard implies equality, which is added
+/// once the guard holds in a model in which the equality does not hold
+void arrayst::add_array_lemma(
+  lazy_typet type,
+  literalt guard,
+  const equal_exprt &equality)
+{
+  if(guard.is_false())
+    return;
+
+  lazy_constraintt lemma(
+    type, implies_exprt(literal_exprt(guard), equality));
+
+  if(active_array_lemmas.find(lemma.lazy)!=active_array_lemmas.end())
+    return;
+
+  // converting the elements of nested arrays may add indices,
+  // which need constraints of their own in post-processing
+  if(guard.is_true() ||
+     ns.follow(equality.lhs().type()).id()==ID_array)
+  {
+    prop.l_set_to_true(convert(lemma.lazy));
+    active_array_lemmas.insert(lemma.lazy);
+  }
+  else
+    array_lemmas.push_back(lemma);
+}
+
+/// adds the array lemmas that the current model violates
+/// \return true iff any lemma has been added
+bool arrayst::add_violated_array_lemmas()
+{
+  bool added=false;
+
+  for(auto it=array_lemmas.begin(); it!=array_lemmas.end(); )
+  {
+    const implies_exprt &lemma=to_implies_expr(it->lazy);
+    literalt guard=to_literal_expr(lemma.op0()).get_literal();
+
+    if(prop.l_get(guard).is_true())
+    {
+      // the elements may not have been converted yet,
+      // in which case they have no value in the model
+      literalt equal=convert(lemma.op1());
+
+      if(!prop.l_get(equal).is_true())
+      {
+        prop.lcnf(!guard, equal);
+        active_array_lemmas.insert(it->lazy);
+        it=array_lemmas.erase(it);
+        added=true;
+        continue;
+      }
+    }
+
+    ++it;
+  }
+
+  return added;
+}
+
+decision_proceduret::resultt arrayst::dec_solve()
+{
+  if(!array_lemmas_on_demand)
+    return SUB::dec_solve();
+
+  std::size_t iterations=0;
+
+  while(true)
+  {
+    decision_proceduret::resultt result=SUB::dec_solve();
+    iterations++;
+
+    if(result!=resultt::D_SATISFIABLE || !add_violated_array_lemmas())
+    {
+      statistics() << "Array lemmas: " << active_array_lemmas.size()
+                   << " added, " << array_lemmas.size() << " avoided, "
+                   << iterations << " iteration(s)" << eom;
+      return result;
+    }
+  }
+}
+
 void arrayst::add_array_constraints()
 {
+  // collected afresh when post-processing again
+  array_lemmas.clear();
+
   collect_indices();
   // at this point all indices should in the index set
 
@@ -346,6 +434,13 @@ void arrayst::add_array_Ackermann_constraints()
 
             equal_exprt values_equal(index_expr1, index_expr2);
 
+            if(array_lemmas_on_demand)
+            {
+              add_array_lemma(
+                lazy_typet::ARRAY_ACKERMANN, indices_equal_lit, values_equal);
+              continue;
+            }
+
             // add constraint
             lazy_constraintt lazy(lazy_typet::ARRAY_ACKERMANN,
               implies_exprt(literal_exprt(indices_equal_lit), values_equal));
@@ -554,6 +649,12 @@ void arrayst::add_array_constraints_with(
 
         equal_exprt equality_expr(index_expr1, index_expr2);
 
+        if(array_lemmas_on_demand)
+        {
+          add_array_lemma(lazy_typet::ARRAY_WITH, !guard_lit, equality_expr);
+          continue;
+        }
+
         // add constraint
         lazy_constraintt lazy(lazy_typet::ARRAY_WITH, or_exprt(equality_expr,
                                 literal_exprt(guard_lit)));
@@ -36,12 +36,18 @@ public:
     SUB::post_process();
   }
 
+  decision_proceduret::resultt dec_solve() override;
+
   // NOLINTNEXTLINE(readability/identifiers)
   typedef equalityt SUB;
 
   literalt record_array_equality(const equal_exprt &expr);
   void record_array_index(const index_exprt &expr);
 
+  // add the Ackermann and read-over-write constraints only once a
+  // model of the formula violates them
+  bool array_lemmas_on_demand;
+
 protected:
   virtual void post_process_arrays()
   {
@@ -98,6 +104,16 @@ protected:
   void add_array_constraint(const lazy_constraintt &lazy, bool refine = true);
   std::map<exprt, bool> expr_map;
 
+  // the Ackermann and read-over-write constraints that are not
+  // added yet if array_lemmas_on_demand is set
+  std::list<lazy_constraintt> array_lemmas;
+  std::set<exprt> active_array_lemmas;
+  void add_array_lemma(
+    lazy_typet type,
+    literalt guard,
+    const equal_exprt &equality);
+  bool add_violated_array_lemmas();
+
   // adds all the constraints eagerly
   void add_array_constraints();
   void add_array_Ackermann_constraints();
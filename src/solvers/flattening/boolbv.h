@@ -89,6 +89,11 @@ public:
 
   boolbv_widtht boolbv_width;
 
+  void set_arith_encoding(const bv_utilst::encodingt &encoding)
+  {
+    bv_utils.encoding=encoding;
+  }
+
 protected:
   bv_utilst bv_utils;
 
@@ -8,6 +8,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "bv_utils.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include <util/arith_tools.h>
@@ -566,59 +567,190 @@ bvt bv_utilst::inverted(const bvt &bv)
   return result;
 }
 
-bvt bv_utilst::wallace_tree(const std::vector<bvt> &pps)
+/// orders the operands of a commutative operation for looking up
+/// the circuit built for them
+static std::pair<bvt, bvt> ordered_operands(const bvt &op0, const bvt &op1)
 {
-  assert(!pps.empty());
-
-  if(pps.size()==1)
-    return pps.front();
-  else if(pps.size()==2)
-    return add(pps[0], pps[1]);
+  if(op1<op0)
+    return std::make_pair(op1, op0);
   else
-  {
-    std::vector<bvt> new_pps;
-    std::size_t no_full_adders=pps.size()/3;
+    return std::make_pair(op0, op1);
+}
+
+literalt bv_utilst::half_adder(
+  literalt a,
+  literalt b,
+  literalt &carry_out)
+{
+  carry_out=prop.land(a, b);
+  return prop.lxor(a, b);
+}
+
+/// Sums up the bits in the given columns, where the bits in column i have
+/// weight 2^i. Wallace trees reduce every group of three bits in a column
+/// with a full adder and remaining pairs with a half adder. Dadda trees
+/// use as few adders as possible to reduce the heights of the columns to
+/// the next element of 2, 3, 4, 6, 9, 13, ... in each stage. Carries out
+/// of the last column are dropped.
+/// \par parameters: the columns, which are consumed, and the kind of tree
+/// \return the sum, which has as many bits as there are columns
+bvt bv_utilst::compress_columns(std::vector<bvt> &columns, bool dadda)
+{
+  const std::size_t width=columns.size();
 
-    // add groups of three partial products using CSA
-    for(std::size_t i=0; i<no_full_adders; i++)
+  std::size_t height=0;
+  for(const auto &column : columns)
+    height=std::max(height, column.size());
+
+  std::vector<std::size_t> targets;
+  for(std::size_t d=2; d<height; d=d*3/2)
+    targets.push_back(d);
+
+  while(height>2)
+  {
+    std::size_t target=2;
+    if(!targets.empty())
     {
-      const bvt &a=pps[i*3+0],
-                &b=pps[i*3+1],
-                &c=pps[i*3+2];
+      target=targets.back();
+      targets.pop_back();
+    }
 
-      assert(a.size()==b.size() && a.size()==c.size());
+    std::vector<bvt> next(width);
 
-      bvt s(a.size()), t(a.size());
+    for(std::size_t c=0; c<width; c++)
+    {
+      const bvt &in=columns[c];
+      std::size_t pos=0;
 
-      for(std::size_t bit=0; bit<a.size(); bit++)
+      while(in.size()-pos>=2)
       {
-        // \todo reformulate using full_adder
-        s[bit]=prop.lxor(a[bit], prop.lxor(b[bit], c[bit]));
-        t[bit]=(bit==0)?const_literal(false):
-               carry(a[bit-1], b[bit-1], c[bit-1]);
+        // the height of the column after this stage if no further
+        // adders are used; the carries from column c-1 are in next[c]
+        std::size_t new_height=next[c].size()+in.size()-pos;
+
+        if(dadda && new_height<=target)
+          break;
+
+        literalt carry;
+
+        if(in.size()-pos>=3 && !(dadda && new_height==target+1))
+        {
+          next[c].push_back(
+            full_adder(in[pos], in[pos+1], in[pos+2], carry));
+          pos+=3;
+        }
+        else
+        {
+          next[c].push_back(half_adder(in[pos], in[pos+1], carry));
+          pos+=2;
+        }
+
+        if(c+1<width)
+          next[c+1].push_back(carry);
       }
 
-      new_pps.push_back(s);
-      new_pps.push_back(t);
+      next[c].insert(next[c].end(), in.begin()+pos, in.end());
     }
 
-    // pass onwards up to two remaining partial products
-    for(std::size_t i=no_full_adders*3; i<pps.size(); i++)
-      new_pps.push_back(pps[i]);
+    columns.swap(next);
+
+    height=0;
+    for(const auto &column : columns)
+      height=std::max(height, column.size());
+  }
+
+  // add the remaining two rows
+  bvt row0=zeros(width), row1=zeros(width);
 
-    assert(new_pps.size()<pps.size());
-    return wallace_tree(new_pps);
+  for(std::size_t c=0; c<width; c++)
+  {
+    if(columns[c].size()>=1)
+      row0[c]=columns[c][0];
+    if(columns[c].size()>=2)
+      row1[c]=columns[c][1];
   }
+
+  return add(row0, row1);
 }
 
-bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
+/// multiplies by summing up the partial product bits in a Wallace or
+/// Dadda tree
+bvt bv_utilst::column_multiplier(const bvt &op0, const bvt &op1, bool dadda)
 {
-  #if 1
-  bvt op0=_op0, op1=_op1;
+  const std::size_t width=op0.size();
 
-  if(is_constant(op1))
-    std::swap(op0, op1);
+  // the partial product bits by their weight; the bits of
+  // weight 2^width and above do not contribute to the product
+  std::vector<bvt> columns(width);
+
+  for(std::size_t i=0; i<width; i++)
+    if(!op0[i].is_false())
+      for(std::size_t j=0; i+j<width; j++)
+      {
+        literalt l=prop.land(op0[i], op1[j]);
+        if(!l.is_false())
+          columns[i+j].push_back(l);
+      }
+
+  return compress_columns(columns, dadda);
+}
+
+/// Multiplies by a constant that is recoded into canonical signed digits
+/// (non-adjacent form), which replaces runs of ones by one addition and
+/// one subtraction. Falls back to shift-and-add if this does not save
+/// any additions.
+bvt bv_utilst::csd_multiplier(const bvt &op, const bvt &constant)
+{
+  const std::size_t width=op.size();
+
+  std::vector<int> digits(width, 0);
+  std::size_t ones=0, non_zero_digits=0;
+  bool carry=false;
+
+  for(std::size_t i=0; i<width; i++)
+  {
+    const bool bit=constant[i].is_true();
+    const bool next_bit=i+1<width && constant[i+1].is_true();
+
+    if(bit)
+      ones++;
+
+    if(bit!=carry)
+    {
+      // the remaining value is odd: choose the digit such that
+      // the remaining value becomes a multiple of four
+      digits[i]=next_bit?-1:1;
+      carry=next_bit;
+      non_zero_digits++;
+    }
+    // otherwise the digit is zero, and the carry stays
+  }
+
+  if(non_zero_digits>=ones)
+    return shift_add_multiplier(constant, op);
+
+  bvt product;
+
+  for(std::size_t i=width; i>0; i--)
+  {
+    const int digit=digits[i-1];
+
+    if(digit==0)
+      continue;
 
+    bvt shifted=shift(op, shiftt::LEFT, i-1);
+
+    if(product.empty())
+      product=digit>0?shifted:negate(shifted);
+    else
+      product=add_sub(product, shifted, digit<0);
+  }
+
+  return product;
+}
+
+bvt bv_utilst::shift_add_multiplier(const bvt &op0, const bvt &op1)
+{
   bvt product;
   product.resize(op0.size());
 
@@ -642,49 +774,63 @@ bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
     }
 
   return product;
-  #else
-  // Wallace tree multiplier. This is disabled, as runtimes have
-  // been observed to go up by 5%-10%, and on some models even by 20%.
-
-  // build the usual quadratic number of partial products
+}
 
+bvt bv_utilst::unsigned_multiplier(const bvt &_op0, const bvt &_op1)
+{
   bvt op0=_op0, op1=_op1;
 
   if(is_constant(op1))
     std::swap(op0, op1);
 
-  std::vector<bvt> pps;
-  pps.reserve(op0.size());
-
-  for(std::size_t bit=0; bit<op0.size(); bit++)
-    if(op0[bit]!=const_literal(false))
-    {
-      bvt pp;
-
-      pp.reserve(op0.size());
+  if(encoding.share)
+  {
+    product_cachet::const_iterator entry=
+      product_cache.find(ordered_operands(op0, op1));
 
-      // zeros according to weight
-      for(std::size_t idx=0; idx<bit; idx++)
-        pp.push_back(const_literal(false));
+    if(entry!=product_cache.end())
+      return entry->second;
+  }
 
-      for(std::size_t idx=bit; idx<op0.size(); idx++)
-        pp.push_back(prop.land(op1[idx-bit], op0[bit]));
+  bvt product;
 
-      pps.push_back(pp);
+  if(encoding.csd_constants && is_constant(op0))
+    product=csd_multiplier(op1, op0);
+  else
+  {
+    switch(encoding.multiplier)
+    {
+    case multipliert::SHIFT_ADD:
+      product=shift_add_multiplier(op0, op1);
+      break;
+    case multipliert::WALLACE:
+      product=column_multiplier(op0, op1, false);
+      break;
+    case multipliert::DADDA:
+      product=column_multiplier(op0, op1, true);
+      break;
     }
+  }
 
-  if(pps.empty())
-    return zeros(op0.size());
-  else
-    return wallace_tree(pps);
+  if(encoding.share)
+    product_cache[ordered_operands(op0, op1)]=product;
 
-  #endif
+  return product;
 }
 
 bvt bv_utilst::unsigned_multiplier_no_overflow(
   const bvt &op0,
   const bvt &op1)
 {
+  if(encoding.share)
+  {
+    product_cachet::const_iterator entry=
+      product_no_overflow_cache.find(ordered_operands(op0, op1));
+
+    if(entry!=product_no_overflow_cache.end())
+      return entry->second;
+  }
+
   bvt _op0=op0, _op1=op1;
 
   if(is_constant(_op1))
@@ -717,6 +863,9 @@ bvt bv_utilst::unsigned_multiplier_no_overflow(
         prop.l_set_to_false(prop.land(op1[idx], op0[sum]));
     }
 
+  if(encoding.share)
+    product_no_overflow_cache[ordered_operands(op0, op1)]=product;
+
   return product;
 }
 
@@ -725,6 +874,10 @@ bvt bv_utilst::signed_multiplier(const bvt &op0, const bvt &op1)
   if(op0.empty() || op1.empty())
     return bvt();
 
+  // the product modulo 2^width does not depend on the representation
+  if(encoding.multiplier!=multipliert::SHIFT_ADD || encoding.csd_constants)
+    return unsigned_multiplier(op0, op1);
+
   literalt sign0=op0[op0.size()-1];
   literalt sign1=op1[op1.size()-1];
 
@@ -860,6 +1013,30 @@ void bv_utilst::divider(
 {
   assert(prop.has_set_to());
 
+  // x/y and x%y share one circuit
+  quotient_cachet &cache=
+    rep==representationt::SIGNED?
+    signed_quotient_cache:unsigned_quotient_cache;
+
+  // the results of dividing by zero are free, and two divisions that may
+  // do so must not be made equal by sharing them
+  const bool share=
+    encoding.share &&
+    is_constant(op1) &&
+    std::find(op1.begin(), op1.end(), const_literal(true))!=op1.end();
+
+  if(share)
+  {
+    quotient_cachet::const_iterator entry=cache.find({op0, op1});
+
+    if(entry!=cache.end())
+    {
+      result=entry->second.first;
+      remainer=entry->second.second;
+      return;
+    }
+  }
+
   switch(rep)
   {
   case representationt::SIGNED:
@@ -868,6 +1045,9 @@ void bv_utilst::divider(
     unsigned_divider(op0, op1, result, remainer); break;
   default: assert(false);
   }
+
+  if(share)
+    cache[{op0, op1}]={result, remainer};
 }
 
 void bv_utilst::unsigned_divider(
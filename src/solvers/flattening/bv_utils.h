@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <map>
 #include <set>
+#include <utility>
 
 #include <util/mp_arith.h>
 
@@ -30,6 +31,29 @@ public:
 
   enum class representationt { SIGNED, UNSIGNED };
 
+  enum class multipliert { SHIFT_ADD, WALLACE, DADDA };
+
+  // how multiplication and division are turned into circuits
+  struct encodingt
+  {
+    // how the partial products are summed up
+    multipliert multiplier;
+    // recode constant factors into canonical signed digits
+    bool csd_constants;
+    // share the circuits of products of equal operands, and those of
+    // quotients by equal nonzero constants
+    bool share;
+
+    encodingt():
+      multiplier(multipliert::SHIFT_ADD),
+      csd_constants(false),
+      share(false)
+    {
+    }
+  };
+
+  encodingt encoding;
+
   bvt build_constant(const mp_integer &i, std::size_t width);
 
   bvt incrementer(const bvt &op, literalt carry_in);
@@ -238,7 +262,19 @@ protected:
 
   bvt cond_negate_no_overflow(const bvt &bv, const literalt cond);
 
-  bvt wallace_tree(const std::vector<bvt> &pps);
+  bvt shift_add_multiplier(const bvt &op0, const bvt &op1);
+  bvt column_multiplier(const bvt &op0, const bvt &op1, bool dadda);
+  bvt csd_multiplier(const bvt &op, const bvt &constant);
+  bvt compress_columns(std::vector<bvt> &columns, bool dadda);
+
+  literalt half_adder(literalt a, literalt b, literalt &carry_out);
+
+  // the circuits built so far if encoding.share is set
+  typedef std::pair<bvt, bvt> operand_pairt;
+  typedef std::map<operand_pairt, bvt> product_cachet;
+  product_cachet product_cache, product_no_overflow_cache;
+  typedef std::map<operand_pairt, operand_pairt> quotient_cachet;
+  quotient_cachet signed_quotient_cache, unsigned_quotient_cache;
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_BV_UTILS_H
@@ -19,38 +19,69 @@ Author: Daniel Kroening, kroening@kroening.com
 // native CNF back-end.
 #define USE_PG
 
+// The n-ary operators build balanced trees, which keeps the depth of
+// the graph logarithmic and gives structural hashing more opportunities
+// to share subtrees.
+
 literalt aig_prop_baset::land(const bvt &bv)
 {
-  literalt literal=const_literal(true);
+  if(bv.empty())
+    return const_literal(true);
 
   // Introduces N-1 extra nodes for N bits
   // See convert_node for where this overhead is removed
-  forall_literals(it, bv)
-    literal=land(*it, literal);
+  bvt level=bv;
+
+  while(level.size()>1)
+  {
+    bvt next;
+    next.reserve((level.size()+1)/2);
+
+    for(std::size_t i=0; i+1<level.size(); i+=2)
+      next.push_back(land(level[i], level[i+1]));
+
+    if(level.size()%2==1)
+      next.push_back(level.back());
+
+    level.swap(next);
+  }
 
-  return literal;
+  return level.front();
 }
 
 literalt aig_prop_baset::lor(const bvt &bv)
 {
-  literalt literal=const_literal(true);
+  bvt negated;
+  negated.reserve(bv.size());
 
-  // Introduces N-1 extra nodes for N bits
-  // See convert_node for where this overhead is removed
   forall_literals(it, bv)
-    literal=land(neg(*it), literal);
+    negated.push_back(neg(*it));
 
-  return neg(literal);
+  return neg(land(negated)); // De Morgan's
 }
 
 literalt aig_prop_baset::lxor(const bvt &bv)
 {
-  literalt literal=const_literal(false);
+  if(bv.empty())
+    return const_literal(false);
 
-  forall_literals(it, bv)
-    literal=lxor(*it, literal);
+  bvt level=bv;
+
+  while(level.size()>1)
+  {
+    bvt next;
+    next.reserve((level.size()+1)/2);
+
+    for(std::size_t i=0; i+1<level.size(); i+=2)
+      next.push_back(lxor(level[i], level[i+1]));
+
+    if(level.size()%2==1)
+      next.push_back(level.back());
 
-  return literal;
+    level.swap(next);
+  }
+
+  return level.front();
 }
 
 literalt aig_prop_baset::land(literalt a, literalt b)
@@ -65,7 +96,114 @@ literalt aig_prop_baset::land(literalt a, literalt b)
   if(a==b)
     return a;
 
-  return dest.new_and_node(a, b);
+  return rewrite_and(a, b);
+}
+
+/// Local two-level rewriting of a conjunction, following Brummayer and
+/// Biere, "Local Two-Level And-Inverter Graph Minimization without
+/// Blowup". The rules only look at the inputs of the inputs, and never
+/// produce more than the one node the conjunction needs anyway.
+/// \par parameters: two literals that are neither constant, equal nor
+///   complementary
+/// \return a literal equivalent to the conjunction of the two
+literalt aig_prop_baset::rewrite_and(literalt a, literalt b)
+{
+  for(unsigned pass=0; pass<2; pass++, std::swap(a, b))
+  {
+    if(!is_and(a))
+      continue;
+
+    const aigt::nodet &node=dest.get_node(a);
+    literalt a0=node.a, a1=node.b;
+
+    if(!a.sign())
+    {
+      // contradiction: (x & y) & !x
+      if(b==neg(a0) || b==neg(a1))
+        return const_literal(false);
+
+      // idempotence: (x & y) & x
+      if(b==a0 || b==a1)
+        return a;
+    }
+    else
+    {
+      // subsumption: !(x & y) & !x
+      if(b==neg(a0) || b==neg(a1))
+        return b;
+
+      // substitution: !(x & y) & x
+      if(b==a0)
+        return land(b, neg(a1));
+      if(b==a1)
+        return land(b, neg(a0));
+    }
+  }
+
+  if(is_and(a) && is_and(b))
+  {
+    const aigt::nodet &node_a=dest.get_node(a);
+    const aigt::nodet &node_b=dest.get_node(b);
+    literalt a0=node_a.a, a1=node_a.b;
+    literalt b0=node_b.a, b1=node_b.b;
+
+    if(!a.sign() && !b.sign())
+    {
+      // contradiction: (x & y) & (!x & z)
+      if(a0==neg(b0) || a0==neg(b1) || a1==neg(b0) || a1==neg(b1))
+        return const_literal(false);
+    }
+    else if(a.sign() && b.sign())
+    {
+      // resolution: !(x & y) & !(x & !y)
+      if((a0==b0 && a1==neg(b1)) || (a0==b1 && a1==neg(b0)))
+        return neg(a0);
+      if((a1==b0 && a0==neg(b1)) || (a1==b1 && a0==neg(b0)))
+        return neg(a1);
+    }
+    else
+    {
+      if(a.sign())
+      {
+        std::swap(a, b);
+        std::swap(a0, b0);
+        std::swap(a1, b1);
+      }
+
+      // now a is an AND and b a NAND
+
+      // subsumption: (x & y) & !(!x & z)
+      if(b0==neg(a0) || b0==neg(a1) || b1==neg(a0) || b1==neg(a1))
+        return a;
+
+      // substitution: (x & y) & !(x & z)
+      if(b0==a0 || b0==a1)
+        return land(a, neg(b1));
+      if(b1==a0 || b1==a1)
+        return land(a, neg(b0));
+    }
+  }
+
+  return and_node(a, b);
+}
+
+/// \return the AND node of the two literals, which is created unless
+///   there is one already
+literalt aig_prop_baset::and_node(literalt a, literalt b)
+{
+  if(b.get()<a.get())
+    std::swap(a, b);
+
+  unsigned long long key=
+    (static_cast<unsigned long long>(a.get())<<32)|b.get();
+
+  std::pair<and_tablet::iterator, bool> entry=
+    and_table.insert(std::make_pair(key, literalt()));
+
+  if(entry.second)
+    entry.first->second=dest.new_and_node(a, b);
+
+  return entry.first->second;
 }
 
 literalt aig_prop_baset::lor(literalt a, literalt b)
@@ -144,20 +282,163 @@ void aig_prop_baset::set_equal(literalt a, literalt b)
 #endif
 }
 
+/// The definitions of the nodes are only passed to the solver in the
+/// phases that the constraints require, and hence the values of the AND
+/// nodes are computed from those of their inputs.
 tvt aig_prop_solvert::l_get(literalt a) const
 {
-  return solver.l_get(a);
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  if(values.size()<aig.nodes.size())
+  {
+    values.resize(aig.nodes.size(), tvt::unknown());
+    has_value.resize(aig.nodes.size(), false);
+  }
+
+  std::vector<literalt::var_not> stack;
+  stack.push_back(a.var_no());
+
+  while(!stack.empty())
+  {
+    literalt::var_not v=stack.back();
+
+    if(has_value[v])
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    const aigt::nodet &node=aig.nodes[v];
+
+    if(!node.is_and() ||
+       (v<encoded_pos.size() && encoded_pos[v] && encoded_neg[v]))
+    {
+      values[v]=solver.l_get(literalt(v, false));
+      has_value[v]=true;
+      stack.pop_back();
+      continue;
+    }
+
+    bool ready=true;
+
+    for(const literalt &input : { node.a, node.b })
+      if(!input.is_constant() && !has_value[input.var_no()])
+      {
+        stack.push_back(input.var_no());
+        ready=false;
+      }
+
+    if(!ready)
+      continue;
+
+    tvt value_a=node.a.is_constant()?
+      tvt(node.a.is_true()):values[node.a.var_no()];
+    tvt value_b=node.b.is_constant()?
+      tvt(node.b.is_true()):values[node.b.var_no()];
+
+    if(node.a.sign())
+      value_a=!value_a;
+    if(node.b.sign())
+      value_b=!value_b;
+
+    values[v]=value_a && value_b;
+    has_value[v]=true;
+    stack.pop_back();
+  }
+
+  tvt result=values[a.var_no()];
+  return a.sign()?!result:result;
 }
 
 propt::resultt aig_prop_solvert::prop_solve()
 {
   status() << "converting AIG, "
            << aig.nodes.size() << " nodes" << eom;
-  convert_aig();
+
+  if(encoded_pos.empty())
+    convert_aig();
+  else
+    convert_incremental();
+
+  values.clear();
+  has_value.clear();
+
+  solver.set_assumptions(assumptions);
 
   return solver.prop_solve();
 }
 
+/// Passes the definitions of the nodes that the given literal depends
+/// on to the solver, in the phases that the literal requires, unless
+/// this has been done before. This uses the plain Tseitin encoding.
+void aig_prop_solvert::encode(literalt l)
+{
+  std::stack<literalt> queue;
+  queue.push(l);
+
+  while(!queue.empty())
+  {
+    literalt l=queue.top();
+    queue.pop();
+
+    if(l.is_constant())
+      continue;
+
+    unsigned var_no=l.var_no();
+    const aigt::nodet &node=aig.nodes[var_no];
+
+    if(!node.is_and())
+      continue;
+
+    literalt o(var_no, false);
+
+    if(l.sign())
+    {
+      if(encoded_neg[var_no])
+        continue;
+
+      encoded_neg[var_no]=true;
+      solver.lcnf({neg(node.a), neg(node.b), o});
+    }
+    else
+    {
+      if(encoded_pos[var_no])
+        continue;
+
+      encoded_pos[var_no]=true;
+      solver.lcnf({neg(o), node.a});
+      solver.lcnf({neg(o), node.b});
+    }
+
+    queue.push(node.a^l.sign());
+    queue.push(node.b^l.sign());
+  }
+}
+
+/// Passes the constraints added since the last call of the solver, and
+/// the definitions of the nodes they and the assumptions depend on, to
+/// the solver.
+void aig_prop_solvert::convert_incremental()
+{
+  while(solver.no_variables()<=aig.nodes.size())
+    solver.new_variable();
+
+  encoded_pos.resize(aig.nodes.size(), false);
+  encoded_neg.resize(aig.nodes.size(), false);
+
+  for(std::size_t i=converted_constraints; i<aig.constraints.size(); i++)
+  {
+    encode(aig.constraints[i]);
+    solver.l_set_to(aig.constraints[i], true);
+  }
+
+  converted_constraints=aig.constraints.size();
+
+  for(const auto &a : assumptions)
+    encode(a);
+}
+
 /// Compute the phase information needed for Plaisted-Greenbaum encoding
 /// \par parameters: Two vectors of bools of size aig.nodes.size()
 /// \return These vectors filled in with per node phase information
@@ -174,6 +455,9 @@ void aig_prop_solvert::compute_phase(
       c_it++)
     queue.push(*c_it);
 
+  for(const auto &a : assumptions)
+    queue.push(a);
+
   while(!queue.empty())
   {
     literalt l=queue.top();
@@ -248,6 +532,18 @@ void aig_prop_solvert::usage_count(
     }
   }
 
+  // the definitions of the assumptions must not be inlined
+  for(const auto &a : assumptions)
+  {
+    if(!a.is_constant())
+    {
+      if(a.sign())
+        ++n_usage_count[a.var_no()];
+      else
+        ++p_usage_count[a.var_no()];
+    }
+  }
+
   for(unsigned n=0; n<aig.nodes.size(); n++)
   {
     const aigt::nodet &node=aig.nodes[n];
@@ -347,6 +643,11 @@ void aig_prop_solvert::convert_node(
   if(p_usage_count[n]>0 || n_usage_count[n]>0)
   {
     literalt o=literalt(n, false);
+
+    // the definition of the node is passed to the solver below
+    encoded_pos[n]=n_pos;
+    encoded_neg[n]=n_neg;
+
     bvt body(2);
     body[0]=node.a;
     body[1]=node.b;
@@ -554,6 +855,9 @@ void aig_prop_solvert::convert_aig()
   while(solver.no_variables()<=aig.nodes.size())
     solver.new_variable();
 
+  encoded_pos.resize(aig.nodes.size(), false);
+  encoded_neg.resize(aig.nodes.size(), false);
+
   // Usage count for inlining
 
   std::vector<unsigned> p_usage_count;
@@ -593,6 +897,5 @@ void aig_prop_solvert::convert_aig()
   for(const auto &c_it : aig.constraints)
     solver.l_set_to(c_it, true);
 
-  // HACK!
-  aig.nodes.clear();
+  converted_constraints=aig.constraints.size();
 }
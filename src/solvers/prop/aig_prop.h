@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_PROP_AIG_PROP_H
 
 #include <cassert>
+#include <memory>
+#include <unordered_map>
 
 #include <util/threeval.h>
 #include <solvers/prop/prop.h>
@@ -62,6 +64,18 @@ public:
 
 protected:
   aigt &dest;
+
+  // structural hashing: the AND node for each pair of inputs, where
+  // the key is made of the smaller and the larger input literal
+  typedef std::unordered_map<unsigned long long, literalt> and_tablet;
+  and_tablet and_table;
+
+  literalt and_node(literalt a, literalt b);
+  literalt rewrite_and(literalt a, literalt b);
+  bool is_and(literalt l) const
+  {
+    return !l.is_constant() && dest.get_node(l).is_and();
+  }
 };
 
 class aig_prop_constraintt:public aig_prop_baset
@@ -92,8 +106,21 @@ class aig_prop_solvert:public aig_prop_constraintt
 public:
   explicit aig_prop_solvert(propt &_solver):
     aig_prop_constraintt(aig),
-    solver(_solver)
+    solver(_solver),
+    converted_constraints(0)
   {
+    // variable 0 is reserved for the constants
+    aig.new_node();
+  }
+
+  // takes ownership of the solver
+  explicit aig_prop_solvert(std::unique_ptr<propt> _solver):
+    aig_prop_constraintt(aig),
+    solver_ptr(std::move(_solver)),
+    solver(*solver_ptr),
+    converted_constraints(0)
+  {
+    aig.new_node();
   }
 
   aig_plus_constraintst aig;
@@ -114,10 +141,48 @@ public:
     solver.set_message_handler(m);
   }
 
+  void set_assumptions(const bvt &_assumptions) override
+  {
+    assumptions=_assumptions;
+  }
+
+  bool has_set_assumptions() const override
+  {
+    return solver.has_set_assumptions();
+  }
+
+  bool is_in_conflict(literalt l) const override
+  {
+    return solver.is_in_conflict(l);
+  }
+
+  bool has_is_in_conflict() const override
+  {
+    return solver.has_is_in_conflict();
+  }
+
+  void set_frozen(literalt a) override
+  {
+    solver.set_frozen(a);
+  }
+
 protected:
+  std::unique_ptr<propt> solver_ptr;
   propt &solver;
+  bvt assumptions;
+
+  // the phases in which the definition of each AND node has been passed
+  // to the solver, and the number of constraints passed to it
+  std::vector<bool> encoded_pos, encoded_neg;
+  std::size_t converted_constraints;
+
+  // the values of the nodes in the last satisfying assignment
+  mutable std::vector<tvt> values;
+  mutable std::vector<bool> has_value;
 
   void convert_aig();
+  void convert_incremental();
+  void encode(literalt l);
   void usage_count(
     std::vector<unsigned> &p_usage_count, std::vector<unsigned> &n_usage_count);
   void compute_phase(std::vector<bool> &n_pos, std::vector<bool> &n_neg);
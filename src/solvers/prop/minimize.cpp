@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "minimize.h"
 
+#include <util/std_expr.h>
+#include <util/std_types.h>
 #include <util/threeval.h>
 
 #include "literal_expr.h"
@@ -33,7 +35,8 @@ void prop_minimizet::objective(
 }
 
 /// Fix objectives that are satisfied
-void prop_minimizet::fix_objectives()
+/// \return true iff an objective was fixed
+bool prop_minimizet::fix_objectives()
 {
   std::vector<objectivet> &entry=current->second;
   bool found=false;
@@ -54,7 +57,137 @@ void prop_minimizet::fix_objectives()
     }
   }
 
-  POSTCONDITION(found);
+  return found;
+}
+
+/// Adds the clause to the problem
+void prop_minimizet::add_clause(const bvt &clause)
+{
+  or_exprt::operandst disjuncts;
+  disjuncts.reserve(clause.size());
+
+  forall_literals(it, clause)
+    disjuncts.push_back(literal_exprt(*it));
+
+  prop_conv.set_to_true(disjunction(disjuncts));
+}
+
+/// \return a fresh literal
+literalt prop_minimizet::new_variable()
+{
+  return prop_conv.convert(
+    symbol_exprt(
+      "prop_minimize::relaxation#"+std::to_string(_number_relaxations++),
+      bool_typet()));
+}
+
+/// Adds a sequential counter that permits at most one of the literals to
+/// be true
+void prop_minimizet::at_most_one(const bvt &literals)
+{
+  if(literals.size()<=1)
+    return;
+
+  literalt previous=literals.front();
+
+  for(std::size_t i=1; i<literals.size(); i++)
+  {
+    // s_i is true if one of the first i+1 literals is true
+    literalt s=new_variable();
+
+    add_clause({!literals[i], !previous});
+    add_clause({!literals[i], s});
+    add_clause({!previous, s});
+
+    previous=s;
+  }
+}
+
+/// Satisfies as many of the objectives of the current weight as possible
+/// by core-guided MaxSAT (Fu and Malik): all objectives are assumed to be
+/// satisfied, and the objectives in the core of each unsatisfiable
+/// call are relaxed such that exactly one of them may be violated.
+/// \return false iff the decision procedure failed
+bool prop_minimizet::solve_core_guided()
+{
+  // the literals to assume, one per unfixed objective
+  bvt soft;
+
+  for(const auto &o : current->second)
+    if(!o.fixed && !o.condition.is_constant())
+      soft.push_back(!o.condition);
+
+  while(true)
+  {
+    _iterations++;
+
+    prop_conv.set_assumptions(soft);
+    decision_proceduret::resultt dec_result=prop_conv.dec_solve();
+
+    if(dec_result==decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      fix_objectives();
+      return true;
+    }
+
+    if(dec_result!=decision_proceduret::resultt::D_UNSATISFIABLE)
+      return false;
+
+    _number_cores++;
+
+    bvt relaxations;
+
+    for(auto &lit : soft)
+      if(prop_conv.is_in_conflict(lit))
+      {
+        literalt relaxation=new_variable();
+        lit=prop_conv.convert(
+          or_exprt(literal_exprt(lit), literal_exprt(relaxation)));
+        relaxations.push_back(relaxation);
+      }
+
+    // the problem is unsatisfiable without the objectives
+    if(relaxations.empty())
+      return false;
+
+    add_clause(relaxations);
+    at_most_one(relaxations);
+  }
+}
+
+/// Satisfies the objectives of the current weight greedily, one call at
+/// a time, each of which must satisfy one more objective.
+/// \return false iff the decision procedure failed
+bool prop_minimizet::solve_greedy()
+{
+  decision_proceduret::resultt dec_result;
+
+  do
+  {
+    // We want to improve on one of the objectives, please!
+    literalt c=constraint();
+
+    if(c.is_false())
+      return true;
+
+    _iterations++;
+
+    bvt assumptions;
+    assumptions.push_back(c);
+    prop_conv.set_assumptions(assumptions);
+    dec_result=prop_conv.dec_solve();
+
+    if(dec_result==decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      bool found=fix_objectives(); // fix the ones we got
+      POSTCONDITION(found);
+    }
+    else if(dec_result!=decision_proceduret::resultt::D_UNSATISFIABLE)
+      return false;
+  }
+  while(dec_result!=decision_proceduret::resultt::D_UNSATISFIABLE);
+
+  return true;
 }
 
 /// Build constraints that require us to improve on at least one goal, greedily.
@@ -97,8 +230,11 @@ void prop_minimizet::operator()()
 
   _iterations=0;
   _number_satisfied=0;
+  _number_cores=0;
   _value=0;
-  bool last_was_SAT=false;
+
+  // the cores tell which objectives conflict
+  const bool core_guided=prop_conv.has_is_in_conflict();
 
   // go from high weights to low ones
   for(current=objectives.rbegin();
@@ -107,51 +243,23 @@ void prop_minimizet::operator()()
   {
     status() << "weight " << current->first << eom;
 
-    decision_proceduret::resultt dec_result;
-    do
+    if(!(core_guided?solve_core_guided():solve_greedy()))
     {
-      // We want to improve on one of the objectives, please!
-      literalt c=constraint();
-
-      if(c.is_false())
-        dec_result=decision_proceduret::resultt::D_UNSATISFIABLE;
-      else
-      {
-        _iterations++;
-
-        bvt assumptions;
-        assumptions.push_back(c);
-        prop_conv.set_assumptions(assumptions);
-        dec_result=prop_conv.dec_solve();
-
-        switch(dec_result)
-        {
-        case decision_proceduret::resultt::D_UNSATISFIABLE:
-          last_was_SAT=false;
-          break;
-
-        case decision_proceduret::resultt::D_SATISFIABLE:
-          last_was_SAT=true;
-          fix_objectives(); // fix the ones we got
-          break;
-
-        default:
-          error() << "decision procedure failed" << eom;
-          last_was_SAT=false;
-          return;
-        }
-      }
+      error() << "decision procedure failed" << eom;
+      return;
     }
-    while(dec_result!=decision_proceduret::resultt::D_UNSATISFIABLE);
   }
 
-  if(!last_was_SAT)
-  {
-    // We don't have a satisfying assignment to work with.
-    // Run solver again to get one.
+  // The last call may have been unsatisfiable, and then we
+  // don't have a satisfying assignment to work with.
+  // Run solver again to get one.
 
-    bvt assumptions; // no assumptions
-    prop_conv.set_assumptions(assumptions);
-    prop_conv.dec_solve();
-  }
+  bvt assumptions; // no assumptions
+  prop_conv.set_assumptions(assumptions);
+  prop_conv.dec_solve();
+
+  statistics() << "Minimization: " << _iterations << " iterations, "
+               << _number_cores << " cores, "
+               << _number_satisfied << " of " << _number_objectives
+               << " objectives satisfied" << eom;
 }
@@ -19,7 +19,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "prop_conv.h"
 
 /// Computes a satisfying assignment of minimal cost according to a const
-/// function using incremental SAT
+/// function using incremental SAT. The objectives are minimized weight by
+/// weight, starting with the largest one. If the decision procedure
+/// provides unsatisfiable cores, the number of satisfied objectives of
+/// each weight is maximal, see solve_core_guided().
 class prop_minimizet:public messaget
 {
 public:
@@ -27,6 +30,8 @@ public:
     _iterations(0),
     _number_satisfied(0),
     _number_objectives(0),
+    _number_cores(0),
+    _number_relaxations(0),
     _value(0),
     prop_conv(_prop_conv)
   {
@@ -46,6 +51,11 @@ public:
     return _iterations;
   }
 
+  std::size_t number_cores() const
+  {
+    return _number_cores;
+  }
+
   std::size_t size() const
   {
     return _number_objectives;
@@ -78,11 +88,19 @@ public:
 protected:
   unsigned _iterations;
   std::size_t _number_satisfied, _number_objectives;
+  std::size_t _number_cores, _number_relaxations;
   weightt _value;
   prop_convt &prop_conv;
 
   literalt constraint();
-  void fix_objectives();
+  bool fix_objectives();
+
+  bool solve_core_guided();
+  bool solve_greedy();
+
+  void add_clause(const bvt &clause);
+  literalt new_variable();
+  void at_most_one(const bvt &literals);
 
   objectivest::reverse_iterator current;
 };
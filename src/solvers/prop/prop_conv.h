@@ -112,6 +112,10 @@ public:
 
   virtual void clear_cache() { cache.clear();}
 
+  // post-process again in the next dec_solve, as required when
+  // the formula has been extended after solving
+  void clear_post_processing() { post_processing_done=false; }
+
   typedef std::map<irep_idt, literalt> symbolst;
   typedef std::unordered_map<exprt, literalt, irep_hash> cachet;
 
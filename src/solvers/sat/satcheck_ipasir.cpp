@@ -102,51 +102,43 @@ propt::resultt satcheck_ipasirt::prop_solve()
       clause_counter << " clauses" << eom;
   }
 
-  // use the internal representation, as ipasir does not support reporting the
-  // status
-  if(status==statust::UNSAT)
+  // if assumptions contains false, we need this to be UNSAT
+  bvt::const_iterator it = std::find_if(assumptions.begin(),
+    assumptions.end(), is_false);
+  const bool has_false = it != assumptions.end();
+
+  // An UNSAT answer under assumptions does not make the instance
+  // inconsistent, and hence the solver is called again even if the
+  // previous call was unsatisfiable.
+  if(has_false)
   {
     messaget::status() <<
-      "SAT checker inconsistent: instance is UNSATISFIABLE" << eom;
+      "got FALSE as assumption: instance is UNSATISFIABLE" << eom;
   }
   else
   {
-    // if assumptions contains false, we need this to be UNSAT
-    bvt::const_iterator it = std::find_if(assumptions.begin(),
-      assumptions.end(), is_false);
-    const bool has_false = it != assumptions.end();
+    forall_literals(it, assumptions)
+      ipasir_assume(solver, it->dimacs());
 
-    if(has_false)
+    // solve the formula, and handle the return code (10=SAT, 20=UNSAT)
+    int solver_state=ipasir_solve(solver);
+    if(10==solver_state)
     {
       messaget::status() <<
-        "got FALSE as assumption: instance is UNSATISFIABLE" << eom;
+        "SAT checker: instance is SATISFIABLE" << eom;
+      status=statust::SAT;
+      return resultt::P_SATISFIABLE;
+    }
+    else if(20==solver_state)
+    {
+      messaget::status() <<
+        "SAT checker: instance is UNSATISFIABLE" << eom;
     }
     else
     {
-      forall_literals(it, assumptions)
-        if(!it->is_false())
-          ipasir_assume(solver, it->dimacs());
-
-      // solve the formula, and handle the return code (10=SAT, 20=UNSAT)
-      int solver_state=ipasir_solve(solver);
-      if(10==solver_state)
-      {
-        messaget::status() <<
-          "SAT checker: instance is SATISFIABLE" << eom;
-        status=statust::SAT;
-        return resultt::P_SATISFIABLE;
-      }
-      else if(20==solver_state)
-      {
-        messaget::status() <<
-          "SAT checker: instance is UNSATISFIABLE" << eom;
-      }
-      else
-      {
-        messaget::status() <<
-          "SAT checker: solving returned without solution" << eom;
-        throw "solving inside IPASIR SAT solver has been interrupted";
-      }
+      messaget::status() <<
+        "SAT checker: solving returned without solution" << eom;
+      throw "solving inside IPASIR SAT solver has been interrupted";
     }
   }
 
@@ -176,21 +168,22 @@ satcheck_ipasirt::~satcheck_ipasirt()
 
 bool satcheck_ipasirt::is_in_conflict(literalt a) const
 {
-  return ipasir_failed(solver, a.var_no());
+  // ipasir_failed expects the literal as it was assumed
+  forall_literals(it, assumptions)
+    if(it->var_no()==a.var_no())
+      return ipasir_failed(solver, it->dimacs())!=0;
+
+  return false;
 }
 
 void satcheck_ipasirt::set_assumptions(const bvt &bv)
 {
-  bvt::const_iterator it = std::find_if(bv.begin(), bv.end(), is_true);
-  const bool has_true = it != bv.end();
+  // true literals hold trivially and are dropped
+  assumptions.clear();
 
-  if(has_true)
-  {
-    assumptions.clear();
-    return;
-  }
-  // only copy assertions, if there is no false in bt parameter
-  assumptions=bv;
+  forall_literals(it, bv)
+    if(!it->is_true())
+      assumptions.push_back(*it);
 }
 
 #endif
@@ -14,7 +14,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <cerrno>
+#endif
+
 #include <cassert>
+#include <sstream>
 #include <stack>
 
 #include <util/invariant.h>
@@ -162,48 +170,9 @@ propt::resultt satcheck_minisat2_baset<T>::prop_solve()
       }
       else
       {
-        Minisat::vec<Minisat::Lit> solver_assumptions;
-        convert(assumptions, solver_assumptions);
-
-        using Minisat::lbool;
-
-#ifndef _WIN32
-
-        void (*old_handler)(int)=SIG_ERR;
+        tvt solver_result=solve_assumptions();
 
-        if(time_limit_seconds!=0)
-        {
-          solver_to_interrupt=solver;
-          old_handler=signal(SIGALRM, interrupt_solver);
-          if(old_handler==SIG_ERR)
-            warning() << "Failed to set solver time limit" << eom;
-          else
-            alarm(time_limit_seconds);
-        }
-
-        lbool solver_result=solver->solveLimited(solver_assumptions);
-
-        if(old_handler!=SIG_ERR)
-        {
-          alarm(0);
-          signal(SIGALRM, old_handler);
-          solver_to_interrupt=solver;
-        }
-
-#else // _WIN32
-
-        if(time_limit_seconds!=0)
-        {
-          messaget::warning() <<
-            "Time limit ignored (not supported on Win32 yet)" << messaget::eom;
-        }
-
-        lbool solver_result=
-          solver->solve(solver_assumptions) ? l_True : l_False;
-
-#endif
-
-        if(solver_result==l_True)
+        if(solver_result.is_true())
         {
           messaget::status() <<
             "SAT checker: instance is SATISFIABLE" << eom;
@@ -211,7 +180,7 @@ propt::resultt satcheck_minisat2_baset<T>::prop_solve()
           status=statust::SAT;
           return resultt::P_SATISFIABLE;
         }
-        else if(solver_result==l_False)
+        else if(solver_result.is_false())
         {
           messaget::status() <<
             "SAT checker: instance is UNSATISFIABLE" << eom;
@@ -238,6 +207,58 @@ propt::resultt satcheck_minisat2_baset<T>::prop_solve()
   }
 }
 
+template<typename T>
+tvt satcheck_minisat2_baset<T>::solve_assumptions()
+{
+  Minisat::vec<Minisat::Lit> solver_assumptions;
+  convert(assumptions, solver_assumptions);
+
+  using Minisat::lbool;
+
+#ifndef _WIN32
+
+  void (*old_handler)(int)=SIG_ERR;
+
+  if(time_limit_seconds!=0)
+  {
+    solver_to_interrupt=solver;
+    old_handler=signal(SIGALRM, interrupt_solver);
+    if(old_handler==SIG_ERR)
+      warning() << "Failed to set solver time limit" << eom;
+    else
+      alarm(time_limit_seconds);
+  }
+
+  lbool solver_result=solver->solveLimited(solver_assumptions);
+
+  if(old_handler!=SIG_ERR)
+  {
+    alarm(0);
+    signal(SIGALRM, old_handler);
+    solver_to_interrupt=solver;
+  }
+
+#else // _WIN32
+
+  if(time_limit_seconds!=0)
+  {
+    messaget::warning() <<
+      "Time limit ignored (not supported on Win32 yet)" << messaget::eom;
+  }
+
+  lbool solver_result=
+    solver->solve(solver_assumptions) ? l_True : l_False;
+
+#endif
+
+  if(solver_result==l_True)
+    return tvt(true);
+  else if(solver_result==l_False)
+    return tvt(false);
+  else
+    return tvt::unknown();
+}
+
 template<typename T>
 void satcheck_minisat2_baset<T>::set_assignment(literalt a, bool value)
 {
@@ -285,14 +306,12 @@ bool satcheck_minisat2_baset<T>::is_in_conflict(literalt a) const
 template<typename T>
 void satcheck_minisat2_baset<T>::set_assumptions(const bvt &bv)
 {
-  assumptions=bv;
+  // true literals hold trivially and are dropped
+  assumptions.clear();
 
-  forall_literals(it, assumptions)
-    if(it->is_true())
-    {
-      assumptions.clear();
-      break;
-    }
+  forall_literals(it, bv)
+    if(!it->is_true())
+      assumptions.push_back(*it);
 }
 
 satcheck_minisat_no_simplifiert::satcheck_minisat_no_simplifiert():
@@ -320,3 +339,317 @@ bool satcheck_minisat_simplifiert::is_eliminated(literalt a) const
 
   return solver->isEliminated(a.var_no());
 }
+
+satcheck_minisat_portfoliot::satcheck_minisat_portfoliot(unsigned _jobs):
+  satcheck_minisat2_baset<Minisat::Solver>(new Minisat::Solver),
+  jobs(_jobs)
+{
+}
+
+const std::string satcheck_minisat_portfoliot::solver_text()
+{
+  return "MiniSAT 2.2.1 portfolio of "+std::to_string(jobs)+" configurations";
+}
+
+bool satcheck_minisat_portfoliot::is_in_conflict(literalt a) const
+{
+  return conflict_vars.find(a.var_no())!=conflict_vars.end();
+}
+
+/// diversifies the search of the given worker; worker 0 keeps the
+/// default configuration
+void satcheck_minisat_portfoliot::configure(unsigned worker)
+{
+  if(worker==0)
+    return;
+
+  solver->random_seed=91648253+worker;
+  solver->random_var_freq=0.01;
+
+  switch(worker%4)
+  {
+  case 0: solver->ccmin_mode=1; break;
+  case 1: solver->rnd_init_act=true; break;
+  case 2: solver->luby_restart=false; solver->restart_first=1000; break;
+  case 3: solver->phase_saving=0; solver->var_decay=0.9; break;
+  }
+}
+
+/// writes the result of a worker, the model or the final conflict, and
+/// the units that hold at decision level 0
+void satcheck_minisat_portfoliot::write_result(
+  tvt result,
+  std::ostream &out) const
+{
+  using Minisat::lbool;
+
+  out << (result.is_true()?1:result.is_false()?0:2) << '\n';
+
+  if(result.is_true())
+  {
+    out << solver->model.size();
+    for(int i=0; i<solver->model.size(); i++)
+      out << ' ' << (solver->model[i]==l_True?1:0);
+    out << '\n';
+  }
+  else if(result.is_false())
+  {
+    out << solver->conflict.size();
+    for(int i=0; i<solver->conflict.size(); i++)
+      out << ' ' << Minisat::var(solver->conflict[i]);
+    out << '\n';
+  }
+
+  std::vector<int> units;
+  for(Minisat::Var v=0; v<solver->nVars(); v++)
+  {
+    lbool value=solver->value(v);
+    if(value!=l_Undef)
+      units.push_back(Minisat::toInt(Minisat::mkLit(v, value==l_False)));
+  }
+
+  out << units.size();
+  for(const auto &unit : units)
+    out << ' ' << unit;
+  out << '\n';
+}
+
+/// reads the result of a worker, and takes over its model or final
+/// conflict and its units
+/// \return true on error
+bool satcheck_minisat_portfoliot::read_result(std::istream &in, tvt &result)
+{
+  int value;
+  if(!(in >> value))
+    return true;
+
+  if(value==2)
+  {
+    result=tvt::unknown();
+    return false;
+  }
+
+  std::size_t size;
+  if(!(in >> size))
+    return true;
+
+  if(value==1)
+  {
+    result=tvt(true);
+    solver->model.clear();
+    solver->model.growTo(size);
+
+    for(std::size_t i=0; i<size; i++)
+    {
+      int v;
+      if(!(in >> v))
+        return true;
+      solver->model[i]=Minisat::lbool(v==1);
+    }
+  }
+  else
+  {
+    result=tvt(false);
+
+    for(std::size_t i=0; i<size; i++)
+    {
+      unsigned v;
+      if(!(in >> v))
+        return true;
+      conflict_vars.insert(v);
+    }
+  }
+
+  std::size_t number_of_units;
+  if(!(in >> number_of_units))
+    return true;
+
+  for(std::size_t i=0; i<number_of_units; i++)
+  {
+    int unit;
+    if(!(in >> unit))
+      return true;
+    solver->addClause(Minisat::toLit(unit));
+  }
+
+  return false;
+}
+
+#ifndef _WIN32
+/// writes all of the given data to a file descriptor
+/// \return true on error
+static bool write_fd(int fd, const std::string &data)
+{
+  std::size_t written=0;
+
+  while(written<data.size())
+  {
+    ssize_t result=write(fd, data.data()+written, data.size()-written);
+
+    if(result==-1 && errno==EINTR)
+      continue;
+    if(result<=0)
+      return true;
+
+    written+=result;
+  }
+
+  return false;
+}
+#endif
+
+tvt satcheck_minisat_portfoliot::solve_assumptions()
+{
+  conflict_vars.clear();
+
+#ifdef _WIN32
+  // there is no fork
+  jobs=1;
+#endif
+
+  if(jobs<=1)
+  {
+    tvt result=satcheck_minisat2_baset<Minisat::Solver>::solve_assumptions();
+
+    for(int i=0; i<solver->conflict.size(); i++)
+      conflict_vars.insert(Minisat::var(solver->conflict[i]));
+
+    return result;
+  }
+
+#ifndef _WIN32
+  struct workert
+  {
+    pid_t pid;
+    int fd;
+    std::string data;
+  };
+
+  std::vector<workert> workers;
+
+  for(unsigned i=0; i<jobs; i++)
+  {
+    int fd[2];
+    if(pipe(fd)==-1)
+      break;
+
+    pid_t pid=fork();
+
+    if(pid==0)
+    {
+      // child
+      close(fd[0]);
+
+      configure(i);
+      tvt result=
+        satcheck_minisat2_baset<Minisat::Solver>::solve_assumptions();
+
+      std::ostringstream out;
+      write_result(result, out);
+
+      bool write_error=write_fd(fd[1], out.str());
+      close(fd[1]);
+
+      _exit(write_error?1:0);
+    }
+
+    close(fd[1]);
+
+    if(pid==-1)
+    {
+      close(fd[0]);
+      break;
+    }
+
+    workers.push_back({pid, fd[0], std::string()});
+  }
+
+  if(workers.empty())
+  {
+    messaget::warning() << "failed to start portfolio workers" << eom;
+    jobs=1;
+    return solve_assumptions();
+  }
+
+  // the first worker that has a definite answer wins
+  tvt result=tvt::unknown();
+  std::size_t running=workers.size();
+
+  while(running>0 && result.is_unknown())
+  {
+    std::vector<pollfd> fds;
+    std::vector<std::size_t> indices;
+
+    for(std::size_t i=0; i<workers.size(); i++)
+      if(workers[i].fd!=-1)
+      {
+        fds.push_back({workers[i].fd, POLLIN, 0});
+        indices.push_back(i);
+      }
+
+    if(poll(fds.data(), fds.size(), -1)==-1)
+    {
+      if(errno==EINTR)
+        continue;
+      break;
+    }
+
+    for(std::size_t j=0; j<fds.size() && result.is_unknown(); j++)
+    {
+      if(fds[j].revents==0)
+        continue;
+
+      workert &worker=workers[indices[j]];
+
+      char buffer[4096];
+      ssize_t n=read(worker.fd, buffer, sizeof(buffer));
+
+      if(n==-1 && errno==EINTR)
+        continue;
+
+      if(n>0)
+      {
+        worker.data.append(buffer, n);
+        continue;
+      }
+
+      // end of file or error: the worker is done
+      close(worker.fd);
+      worker.fd=-1;
+      running--;
+
+      std::istringstream in(worker.data);
+      tvt worker_result;
+      if(read_result(in, worker_result))
+      {
+        conflict_vars.clear();
+        messaget::warning() << "portfolio worker " << indices[j]
+                            << " failed" << eom;
+      }
+      else if(!worker_result.is_unknown())
+      {
+        result=worker_result;
+        messaget::statistics() << "portfolio worker " << indices[j]
+                               << " answered first" << eom;
+      }
+    }
+  }
+
+  for(auto &worker : workers)
+  {
+    if(worker.fd!=-1)
+    {
+      kill(worker.pid, SIGKILL);
+      close(worker.fd);
+    }
+
+    while(waitpid(worker.pid, nullptr, 0)==-1 && errno==EINTR)
+    {
+    }
+  }
+
+  return result;
+#else
+  UNREACHABLE;
+#endif
+}
@@ -10,6 +10,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
 #define CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
 
+#include <set>
+
 #include "cnf.h"
 
 // Select one: basic solver or with simplification.
@@ -57,6 +59,9 @@ protected:
 
   void add_variables();
   bvt assumptions;
+
+  // solves under the assumptions, unknown if interrupted
+  virtual tvt solve_assumptions();
 };
 
 class satcheck_minisat_no_simplifiert:
@@ -77,4 +82,32 @@ public:
   bool is_eliminated(literalt a) const;
 };
 
+/// Races differently configured copies of the solver against each other
+/// in worker processes. The workers are forked for each call of
+/// prop_solve, and hence start from all clauses added so far. The answer
+/// of the first worker that finishes is taken, and the others are
+/// killed. The units the winner has derived are added to the clauses
+/// of this process, which shares them with the workers of later calls.
+class satcheck_minisat_portfoliot:
+  public satcheck_minisat2_baset<Minisat::Solver>
+{
+public:
+  explicit satcheck_minisat_portfoliot(unsigned _jobs);
+  virtual const std::string solver_text() final;
+
+  virtual bool is_in_conflict(literalt a) const override;
+
+protected:
+  unsigned jobs;
+
+  // the variables in the final conflict of the last call
+  std::set<unsigned> conflict_vars;
+
+  virtual tvt solve_assumptions() override;
+
+  void configure(unsigned worker);
+  void write_result(tvt result, std::ostream &out) const;
+  bool read_result(std::istream &in, tvt &result);
+};
+
 #endif // CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
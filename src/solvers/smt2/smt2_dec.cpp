@@ -24,6 +24,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/tempfile.h>
 #include <util/arith_tools.h>
 #include <util/ieee_float.h>
+#include <util/make_unique.h>
 
 #include "smt2irep.h"
 
@@ -63,18 +64,41 @@ smt2_temp_filet::~smt2_temp_filet()
     unlink(temp_result_filename.c_str());
 }
 
+smt2_dect::~smt2_dect()
+{
+  if(process)
+  {
+    *process << "(exit)\n" << std::flush;
+    process->wait();
+  }
+}
+
 decision_proceduret::resultt smt2_dect::dec_solve()
+{
+  if(use_pipe)
+    return dec_solve_pipe();
+  else
+    return dec_solve_file();
+}
+
+decision_proceduret::resultt smt2_dect::dec_solve_file()
 {
   // we write the problem into a file
   smt2_temp_filet smt2_temp_file;
 
+  // The footer converts the assumptions into the string buffer, and
+  // hence is written there, and removed again afterwards, as later
+  // calls continue the formula.
+  const std::string formula=stringstream.str();
+  write_footer(stringstream);
+
   // copy from string buffer into file
   smt2_temp_file.temp_out << stringstream.str();
-
-  // this finishes up and closes the SMT2 file
-  write_footer(smt2_temp_file.temp_out);
   smt2_temp_file.temp_out.close();
 
+  stringstream.str(formula);
+  stringstream.seekp(0, std::ios::end);
+
   smt2_temp_file.temp_result_filename=
     get_temporary_file("smt2_dec_result_", "");
 
@@ -169,15 +193,174 @@ decision_proceduret::resultt smt2_dect::dec_solve()
   return read_result(in);
 }
 
+/// \return true if the solver cannot be used through a pipe
+bool smt2_dect::get_pipe_command(
+  std::string &executable,
+  std::list<std::string> &args)
+{
+  switch(solver)
+  {
+  case solvert::CVC4:
+    executable="cvc4";
+    args={"-L", "smt2", "--incremental"};
+    return false;
+
+  case solvert::YICES:
+    executable="yices-smt2";
+    args={"--incremental"};
+    return false;
+
+  case solvert::Z3:
+    executable="z3";
+    args={"-smt2", "-in"};
+    return false;
+
+  default:
+    return true;
+  }
+}
+
+/// Passes the part of the formula that is new since the last call to
+/// the solver process, which is started by the first call. The
+/// assumptions are passed to check-sat-assuming, and the object sizes,
+/// which depend on the objects known so far, are asserted in a scope
+/// that is popped after the check.
+decision_proceduret::resultt smt2_dect::dec_solve_pipe()
+{
+  if(!process)
+  {
+    std::string executable;
+    std::list<std::string> args;
+
+    if(get_pipe_command(executable, args))
+    {
+      warning() << "SMT2 solver cannot be used through a pipe, "
+                << "using files instead" << eom;
+      use_pipe=false;
+      return dec_solve_file();
+    }
+
+    process=util_make_unique<pipe_streamt>(executable, args);
+
+    if(process->run()<0)
+    {
+      error() << "error running SMT2 solver" << eom;
+      process.reset();
+      return decision_proceduret::resultt::D_ERROR;
+    }
+  }
+
+  bvt assumption_literals;
+
+  for(const auto &l : assumptions)
+  {
+    if(l.is_false())
+      return decision_proceduret::resultt::D_UNSATISFIABLE;
+    else if(!l.is_true())
+      assumption_literals.push_back(l);
+  }
+
+  out << "\n(push 1)\n";
+
+  for(const auto &object : object_sizes)
+    define_object_size(object.second, object.first);
+
+  out << "(check-sat-assuming (";
+  for(const auto &l : assumption_literals)
+  {
+    out << ' ';
+    convert_literal(l);
+  }
+  out << "))\n";
+
+  *process << stringstream.str() << std::flush;
+  stringstream.str("");
+
+  decision_proceduret::resultt res=resultt::D_ERROR;
+
+  irept parsed=smt2irep(*process);
+
+  if(parsed.id()=="sat")
+    res=resultt::D_SATISFIABLE;
+  else if(parsed.id()=="unsat")
+    res=resultt::D_UNSATISFIABLE;
+  else
+  {
+    error() << "SMT2 solver returned unexpected answer `"
+            << parsed.pretty() << "'" << eom;
+  }
+
+  if(res==resultt::D_SATISFIABLE && !smt2_identifiers.empty())
+  {
+    valuest values;
+
+    if(get_values_pipe(smt2_identifiers, values))
+    {
+      // the solver rejects the entire query if it fails on one of the
+      // identifiers, and then the others are asked for one at a time
+      warning() << "SMT2 solver rejected get-value, "
+                << "asking for each identifier separately" << eom;
+
+      values.clear();
+
+      for(const auto &id : smt2_identifiers)
+        if(get_values_pipe({id}, values))
+          warning() << "SMT2 solver has no value for `" << id << "'" << eom;
+    }
+
+    set_values(values);
+  }
+
+  // sent with the next call
+  out << "(pop 1)\n";
+
+  if(!*process)
+  {
+    error() << "lost connection to SMT2 solver" << eom;
+    return decision_proceduret::resultt::D_ERROR;
+  }
+
+  return res;
+}
+
+/// asks the solver process for the values of \p identifiers, and adds
+/// them to \p values
+/// \return true iff the solver returned an error message
+bool smt2_dect::get_values_pipe(
+  const smt2_identifierst &identifiers,
+  valuest &values)
+{
+  out << "(get-value (";
+  for(const auto &id : identifiers)
+    out << " |" << id << '|';
+  out << "))\n";
+
+  *process << stringstream.str() << std::flush;
+  stringstream.str("");
+
+  irept parsed=smt2irep(*process);
+
+  if(parsed.id()=="" &&
+     parsed.get_sub().size()==2 &&
+     parsed.get_sub().front().id()=="error")
+  {
+    debug() << "SMT2 solver returned error message:\n"
+            << "\t\"" << parsed.get_sub()[1].id() <<"\"" << eom;
+    return true;
+  }
+
+  for(const auto &value : parsed.get_sub())
+    if(value.get_sub().size()==2)
+      values[value.get_sub()[0].id()]=value.get_sub()[1];
+
+  return false;
+}
+
 decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
 {
   std::string line;
   decision_proceduret::resultt res=resultt::D_ERROR;
 
-  boolean_assignment.clear();
-  boolean_assignment.resize(no_boolean_variables, false);
-
-  typedef std::unordered_map<irep_idt, irept, irep_id_hash> valuest;
   valuest values;
 
   while(in)
@@ -216,6 +399,18 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     }
   }
 
+  set_values(values);
+
+  return res;
+}
+
+/// sets the values of the identifiers and the Booleans from the values
+/// returned by the solver
+void smt2_dect::set_values(valuest &values)
+{
+  boolean_assignment.clear();
+  boolean_assignment.resize(no_boolean_variables, false);
+
   for(identifier_mapt::iterator
       it=identifier_map.begin();
       it!=identifier_map.end();
@@ -232,6 +427,4 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     const irept &value=values["B"+std::to_string(v)];
     boolean_assignment[v]=(value.id()==ID_true);
   }
-
-  return res;
 }
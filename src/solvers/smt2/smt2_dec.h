@@ -11,6 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_SMT2_SMT2_DEC_H
 
 #include <fstream>
+#include <list>
+#include <memory>
+
+#include <util/pipe_stream.h>
 
 #include "smt2_conv.h"
 
@@ -41,18 +45,40 @@ public:
     const std::string &_notes,
     const std::string &_logic,
     solvert _solver):
-    smt2_convt(_ns, _benchmark, _notes, _logic, _solver, stringstream)
+    smt2_convt(_ns, _benchmark, _notes, _logic, _solver, stringstream),
+    use_pipe(false)
   {
   }
 
+  ~smt2_dect();
+
   virtual resultt dec_solve();
   virtual std::string decision_procedure_text() const;
 
   // yes, we are incremental!
   virtual bool has_set_assumptions() const { return true; }
 
+  /// Keep one solver process running for all calls of dec_solve, and
+  /// pass it only what is new since the previous call, instead of
+  /// writing the entire formula into a file for a new process each time
+  void set_use_pipe(bool value)
+  {
+    use_pipe=value;
+  }
+
 protected:
+  bool use_pipe;
+  std::unique_ptr<pipe_streamt> process;
+
+  typedef std::unordered_map<irep_idt, irept, irep_id_hash> valuest;
+
   resultt read_result(std::istream &in);
+  void set_values(valuest &values);
+
+  resultt dec_solve_file();
+  resultt dec_solve_pipe();
+  bool get_values_pipe(const smt2_identifierst &identifiers, valuest &values);
+  bool get_pipe_command(std::string &executable, std::list<std::string> &args);
 };
 
 #endif // CPROVER_SOLVERS_SMT2_SMT2_DEC_H
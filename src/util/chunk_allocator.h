@@ -0,0 +1,257 @@
+/*******************************************************************\
+
+Module: Allocating Container Nodes in Chunks
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Allocating Container Nodes in Chunks
+
+#ifndef CPROVER_UTIL_CHUNK_ALLOCATOR_H
+#define CPROVER_UTIL_CHUNK_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "invariant.h"
+
+/// Hands out memory for objects of one size from chunks that hold many
+/// of them. Objects allocated one after the other are adjacent in
+/// memory, which makes traversing node-based containers such as
+/// std::list in insertion order cache-friendly. Freed objects are
+/// reused; the chunks are released when the pool is destroyed.
+class chunk_poolt
+{
+public:
+  explicit chunk_poolt(std::size_t _objects_per_chunk=1024):
+    object_size(0),
+    objects_per_chunk(_objects_per_chunk),
+    used(_objects_per_chunk),
+    free_list(nullptr)
+  {
+  }
+
+  chunk_poolt(const chunk_poolt &)=delete;
+  chunk_poolt &operator=(const chunk_poolt &)=delete;
+
+  ~chunk_poolt()
+  {
+    for(const auto &chunk : chunks)
+      ::operator delete(chunk);
+  }
+
+  /// \return nullptr if the pool is used for objects of another size
+  void *allocate(std::size_t size)
+  {
+    if(object_size==0)
+      object_size=rounded(size);
+    else if(rounded(size)!=object_size)
+      return nullptr;
+
+    if(free_list!=nullptr)
+    {
+      void *result=free_list;
+      free_list=*static_cast<void **>(free_list);
+      return result;
+    }
+
+    if(used==objects_per_chunk)
+    {
+      chunks.push_back(
+        static_cast<char *>(::operator new(object_size*objects_per_chunk)));
+      used=0;
+    }
+
+    return chunks.back()+object_size*(used++);
+  }
+
+  void deallocate(void *p)
+  {
+    *static_cast<void **>(p)=free_list;
+    free_list=p;
+  }
+
+  bool owns_size(std::size_t size) const
+  {
+    return object_size!=0 && rounded(size)==object_size;
+  }
+
+  std::size_t number_of_chunks() const
+  {
+    return chunks.size();
+  }
+
+  std::size_t chunk_size() const
+  {
+    return object_size*objects_per_chunk;
+  }
+
+  /// Returns the chunks none of whose objects are in use to the heap.
+  /// The chunk that objects are currently taken from is kept.
+  /// \return the number of chunks released
+  std::size_t release_unused_chunks()
+  {
+    if(chunks.size()<2)
+      return 0;
+
+    // the chunks but the last, ordered by address
+    std::vector<char *> sorted(chunks.begin(), std::prev(chunks.end()));
+    std::sort(sorted.begin(), sorted.end(), std::less<const char *>());
+
+    std::vector<std::size_t> free_objects(sorted.size(), 0);
+
+    for(void *p=free_list; p!=nullptr; p=*static_cast<void **>(p))
+    {
+      std::size_t i=chunk_index(sorted, p);
+      if(i<sorted.size())
+        free_objects[i]++;
+    }
+
+    // rebuild the free list without the objects of the released chunks
+    void **tail=&free_list;
+    for(void *p=free_list; p!=nullptr; p=*static_cast<void **>(p))
+    {
+      std::size_t i=chunk_index(sorted, p);
+      if(i==sorted.size() || free_objects[i]!=objects_per_chunk)
+      {
+        *tail=p;
+        tail=static_cast<void **>(p);
+      }
+    }
+    *tail=nullptr;
+
+    std::size_t released=0;
+    char *current=chunks.back();
+    chunks.clear();
+
+    for(std::size_t i=0; i<sorted.size(); i++)
+    {
+      if(free_objects[i]==objects_per_chunk)
+      {
+        ::operator delete(sorted[i]);
+        released++;
+      }
+      else
+        chunks.push_back(sorted[i]);
+    }
+
+    chunks.push_back(current);
+
+    return released;
+  }
+
+protected:
+  std::size_t object_size;
+  std::size_t objects_per_chunk;
+  std::size_t used;
+  std::vector<char *> chunks;
+  void *free_list;
+
+  /// \return the index of the chunk in sorted that contains p, or
+  ///   sorted.size() if there is none
+  std::size_t chunk_index(
+    const std::vector<char *> &sorted,
+    const void *p) const
+  {
+    // std::less gives a total order on unrelated pointers
+    const std::less<const char *> less;
+    const char *c=static_cast<const char *>(p);
+    auto it=std::upper_bound(sorted.begin(), sorted.end(), c, less);
+    if(it==sorted.begin() || !less(c, *std::prev(it)+chunk_size()))
+      return sorted.size();
+    return std::distance(sorted.begin(), std::prev(it));
+  }
+
+  static std::size_t rounded(std::size_t size)
+  {
+    const std::size_t alignment=alignof(std::max_align_t);
+    if(size<sizeof(void *))
+      size=sizeof(void *);
+    return (size+alignment-1)/alignment*alignment;
+  }
+};
+
+/// An allocator for node-based containers that places single nodes
+/// into a chunk_poolt. Copies of the allocator, including those rebound
+/// to the node type of the container, share the pool, and hence
+/// containers that use copies of one allocator can splice nodes between
+/// each other. Arrays and objects of other sizes use operator new.
+template<typename T>
+class chunk_allocatort
+{
+public:
+  typedef T value_type;
+
+  // the nodes stay in the pool they were allocated from
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  chunk_allocatort():pool(std::make_shared<chunk_poolt>())
+  {
+  }
+
+  // moving must leave the source usable, hence there is no move
+  // constructor
+  chunk_allocatort(const chunk_allocatort &)=default;
+  chunk_allocatort &operator=(const chunk_allocatort &)=default;
+
+  template<typename U>
+  // NOLINTNEXTLINE(runtime/explicit)
+  chunk_allocatort(const chunk_allocatort<U> &other):pool(other.pool)
+  {
+  }
+
+  T *allocate(std::size_t n)
+  {
+    if(n==1)
+    {
+      void *p=pool->allocate(sizeof(T));
+      if(p!=nullptr)
+        return static_cast<T *>(p);
+    }
+
+    return static_cast<T *>(::operator new(n*sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n)
+  {
+    if(n==1 && pool->owns_size(sizeof(T)))
+      pool->deallocate(p);
+    else
+      ::operator delete(p);
+  }
+
+  template<typename U>
+  bool operator==(const chunk_allocatort<U> &other) const
+  {
+    return pool==other.pool;
+  }
+
+  template<typename U>
+  bool operator!=(const chunk_allocatort<U> &other) const
+  {
+    return pool!=other.pool;
+  }
+
+  const chunk_poolt &get_pool() const
+  {
+    PRECONDITION(pool);
+    return *pool;
+  }
+
+protected:
+  std::shared_ptr<chunk_poolt> pool;
+
+  template<typename U>
+  friend class chunk_allocatort;
+};
+
+#endif // CPROVER_UTIL_CHUNK_ALLOCATOR_H
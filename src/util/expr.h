@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #define OPERANDS_IN_GETSUB
 
+#include <list>
+
 #include "type.h"
 
 #define forall_operands(it, expr) \
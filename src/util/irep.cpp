@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <ostream>
 
+#include "chunk_allocator.h"
 #include "invariant.h"
 #include "string2int.h"
 #include "string_hash.h"
@@ -53,6 +54,58 @@ static inline irept::named_subt::iterator named_subt_lower_bound(
 }
 #endif
 
+#ifdef IREP_POOL
+static irept::statisticst irep_statistics;
+
+/// The pool is never destroyed, as ireps with static storage duration
+/// may be destroyed after any other static object.
+static chunk_poolt &dt_pool()
+{
+  static chunk_poolt *pool=new chunk_poolt(4096);
+  return *pool;
+}
+
+void *irept::dt::operator new(std::size_t size)
+{
+  void *p=dt_pool().allocate(size);
+  INVARIANT(p!=nullptr, "all nodes have the same size");
+
+  irep_statistics.nodes_allocated++;
+  irep_statistics.nodes_alive++;
+  if(irep_statistics.nodes_alive>irep_statistics.peak_nodes_alive)
+    irep_statistics.peak_nodes_alive=irep_statistics.nodes_alive;
+
+  return p;
+}
+
+void irept::dt::operator delete(void *p)
+{
+  irep_statistics.nodes_alive--;
+  dt_pool().deallocate(p);
+}
+#endif
+
+irept::statisticst irept::get_statistics()
+{
+  #ifdef IREP_POOL
+  statisticst result=irep_statistics;
+  result.chunks=dt_pool().number_of_chunks();
+  result.chunk_bytes=result.chunks*dt_pool().chunk_size();
+  return result;
+  #else
+  return statisticst{0, 0, 0, 0, 0};
+  #endif
+}
+
+std::size_t irept::release_unused_memory()
+{
+  #ifdef IREP_POOL
+  return dt_pool().release_unused_chunks()*dt_pool().chunk_size();
+  #else
+  return 0;
+  #endif
+}
+
 const irept &get_nil_irep()
 {
   if(nil_rep_storage.id().empty()) // initialized?
@@ -113,6 +166,11 @@ void irept::remove_ref(dt *old_data)
   #endif
 
   old_data->ref_count--;
+  #ifdef HASH_CODE
+  // the node is no longer shared, see irept::hash()
+  if(old_data->ref_count==1)
+    old_data->hash_code=0;
+  #endif
   if(old_data->ref_count==0)
   {
     #ifdef IREP_DEBUG
@@ -150,6 +208,10 @@ void irept::nonrecursive_destructor(dt *old_data)
 
     INVARIANT(d->ref_count!=0, "All contents of the stack must be in use");
     d->ref_count--;
+    #ifdef HASH_CODE
+    if(d->ref_count==1)
+      d->hash_code=0;
+    #endif
 
     if(d->ref_count==0)
     {
@@ -362,6 +424,19 @@ bool irept::operator==(const irept &other) const
     return true;
   #endif
 
+  #ifdef HASH_CODE
+  // differing hash codes imply differing ireps
+  if(data->hash_code!=0 &&
+     other.data->hash_code!=0 &&
+     data->hash_code!=other.data->hash_code)
+  {
+    #ifdef IREP_HASH_STATS
+    ++irep_cmp_ne_cnt;
+    #endif
+    return false;
+  }
+  #endif
+
   if(id()!=other.id() ||
      get_sub()!=other.get_sub() || // recursive call
      get_named_sub()!=other.get_named_sub()) // recursive call
@@ -595,7 +670,13 @@ std::size_t irept::hash() const
   result=hash_finalize(result, named_sub.size()+sub.size());
 
   #ifdef HASH_CODE
-  read().hash_code=result;
+  // Only shared nodes keep their hash code. Nodes that are not shared may
+  // be modified in place through a reference obtained from, e.g., get_sub()
+  // on one of their ancestors, which would not reset the hash code of this
+  // node. Shared nodes are copied before they are modified, and drop
+  // their hash code when they stop being shared.
+  if(data->ref_count>1)
+    data->hash_code=result;
   #endif
   #ifdef IREP_HASH_STATS
   ++irep_hash_cnt;
@@ -21,9 +21,23 @@ Author: Daniel Kroening, kroening@kroening.com
 // #define HASH_CODE
 #define USE_MOVE
 // #define SUB_IS_LIST
+#define NAMED_SUB_IS_FLAT
+#define IREP_POOL
+
+// The hash codes are kept in shared nodes only, see irept::hash().
+#if defined(HASH_CODE) && !defined(SHARING)
+#error "HASH_CODE requires SHARING"
+#endif
+
+// Only shared nodes are allocated individually.
+#if defined(IREP_POOL) && !defined(SHARING)
+#error "IREP_POOL requires SHARING"
+#endif
 
 #ifdef SUB_IS_LIST
 #include <list>
+#elif defined(NAMED_SUB_IS_FLAT)
+#include "stable_flat_map.h"
 #else
 #include <map>
 #endif
@@ -96,6 +110,9 @@ public:
 
   #ifdef SUB_IS_LIST
   typedef std::list<std::pair<irep_namet, irept> > named_subt;
+  #elif defined(NAMED_SUB_IS_FLAT)
+  // most ireps have few named subs, which are found in a sorted vector
+  typedef stable_flat_mapt<irep_namet, irept> named_subt;
   #else
   typedef std::map<irep_namet, irept> named_subt;
   #endif
@@ -256,6 +273,24 @@ public:
 
   std::string pretty(unsigned indent=0, unsigned max_indent=0) const;
 
+  /// counters for the nodes of all ireps, see --show-irep-stats
+  struct statisticst
+  {
+    std::size_t nodes_alive;
+    std::size_t peak_nodes_alive;
+    std::size_t nodes_allocated;
+    std::size_t chunks;
+    std::size_t chunk_bytes;
+  };
+
+  static statisticst get_statistics();
+
+  /// Returns the memory of the chunks of the node pool that hold no
+  /// live nodes to the heap, e.g., after a phase that created and
+  /// freed many ireps.
+  /// \return the number of bytes released
+  static std::size_t release_unused_memory();
+
 protected:
   static bool is_comment(const irep_namet &name)
   { return !name.empty() && name[0]=='#'; }
@@ -302,6 +337,12 @@ public:
       #endif
     }
 
+    #ifdef IREP_POOL
+    // the nodes are taken from a pool of chunks
+    static void *operator new(std::size_t size);
+    static void operator delete(void *p);
+    #endif
+
     #ifdef SHARING
     dt():ref_count(1)
       #ifdef HASH_CODE
@@ -43,10 +43,13 @@ const char *irep_ids_table[]=
 
 #include "irep_ids.def" // NOLINT(build/include)
 
-string_containert::string_containert()
+string_containert::string_containert():next_number(0)
 {
+  for(auto &block : blocks)
+    block.store(nullptr, std::memory_order_relaxed);
+
   // pre-allocate empty string -- this gets index 0
-  get("");
+  operator[]("");
 
   // allocate strings
   for(unsigned i=0; irep_ids_table[i]!=nullptr; i++)
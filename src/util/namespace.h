@@ -109,6 +109,9 @@ public:
 
 protected:
   const symbol_tablet *symbol_table1, *symbol_table2;
+
+  // tracks the symbol tables the cached results depend on
+  friend class simplify_expr_cachet;
 };
 
 class multi_namespacet:public namespacet
@@ -159,12 +159,12 @@ int pipe_streamt::run()
 
     _argv[args.size()+1]=nullptr;
 
-    int result=execvp(executable.c_str(), _argv.data());
+    execvp(executable.c_str(), _argv.data());
 
-    if(result==-1)
-      perror(nullptr);
-
-    return result;
+    // only returns on error, and the child must not continue as a copy
+    // of the parent
+    perror(nullptr);
+    _exit(1);
   }
   else if(pid==-1)
   {
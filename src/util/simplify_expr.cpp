@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "c_types.h"
 #include "rational.h"
 #include "simplify_expr_class.h"
+#include "simplify_expr_cache.h"
 #include "mp_arith.h"
 #include "arith_tools.h"
 #include "replace_expr.h"
@@ -41,30 +42,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #endif
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
-{
-public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
-
-  containert container_normal;
-
-  containert &container()
-  {
-    return container_normal;
-  }
-};
-
-simplify_expr_cachet simplify_expr_cache;
-#endif
-
 bool simplify_exprt::simplify_abs(exprt &expr)
 {
   if(expr.operands().size()!=1)
@@ -2355,25 +2332,6 @@ bool simplify_exprt::simplify_node(exprt &expr)
 /// \return returns true if expression unchanged; returns false if changed
 bool simplify_exprt::simplify_rec(exprt &expr)
 {
-  // look up in cache
-
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
-
-  if(!cache_result.second) // found!
-  {
-    const exprt &new_expr=cache_result.first->second;
-
-    if(new_expr.id().empty())
-      return true; // no change
-
-    expr=new_expr;
-    return false;
-  }
-  #endif
-
   // We work on a copy to prevent unnecessary destruction of sharing.
   exprt tmp=expr;
   bool result=true;
@@ -2402,11 +2360,6 @@ bool simplify_exprt::simplify_rec(exprt &expr)
   if(!result)
   {
     expr.swap(tmp);
-
-    #ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second=expr;
-    #endif
   }
 
   return result;
@@ -2418,7 +2371,37 @@ bool simplify_exprt::simplify(exprt &expr)
   if(debug_on)
     std::cout << "TO-SIMP " << from_expr(ns, "", expr) << "\n";
 #endif
+
+  // The cache is consulted for the expressions passed in here only, as
+  // hashing every subexpression in simplify_rec would cost more than
+  // it saves. The results depend on the options of this instance.
+  const bool use_cache=
+    simplify_expr_cache.enabled() &&
+    do_simplify_if &&
+    local_replace_map.empty();
+
+  if(use_cache)
+  {
+    exprt cached;
+    if(simplify_expr_cache.lookup(ns, expr, cached))
+    {
+      if(cached.is_nil())
+        return true; // no change
+
+      expr=cached;
+      return false;
+    }
+  }
+
+  exprt original;
+  if(use_cache)
+    original=expr;
+
   bool res=simplify_rec(expr);
+
+  if(use_cache)
+    simplify_expr_cache.insert(ns, original, res?nil_exprt():expr);
+
 #ifdef DEBUG_ON_DEMAND
   if(debug_on)
     std::cout << "FULLSIMP " << from_expr(ns, "", expr) << "\n";
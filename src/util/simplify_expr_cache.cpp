@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+Module: Cache for the Expression Simplifier
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Cache for the Expression Simplifier
+
+#include "simplify_expr_cache.h"
+
+#include <typeinfo>
+
+#include "namespace.h"
+#include "symbol_table.h"
+
+simplify_expr_cachet simplify_expr_cache;
+
+/// flushes the cache if the symbols visible through the namespace
+/// differ from those the entries were computed with
+/// \return false if the namespace cannot be cached
+bool simplify_expr_cachet::check_namespace(const namespacet &ns)
+{
+  // namespaces that look up symbols differently are not tracked
+  if(typeid(ns)!=typeid(namespacet))
+    return false;
+
+  symbolst current;
+  current.symbol_table1=ns.symbol_table1;
+  current.symbol_table2=ns.symbol_table2;
+  current.generation1=
+    current.symbol_table1==nullptr?0:current.symbol_table1->get_generation();
+  current.generation2=
+    current.symbol_table2==nullptr?0:current.symbol_table2->get_generation();
+
+  if(!(current==symbols))
+  {
+    if(!entries.empty())
+      flushes++;
+
+    entries.clear();
+    index.clear();
+    symbols=current;
+  }
+
+  return true;
+}
+
+bool simplify_expr_cachet::lookup(
+  const namespacet &ns,
+  const exprt &expr,
+  exprt &result)
+{
+  if(!enabled() || !check_namespace(ns))
+    return false;
+
+  indext::const_iterator it=index.find(expr);
+
+  if(it==index.end())
+  {
+    misses++;
+    return false;
+  }
+
+  hits++;
+
+  // move to the front
+  entries.splice(entries.begin(), entries, it->second);
+  result=it->second->second;
+
+  return true;
+}
+
+void simplify_expr_cachet::insert(
+  const namespacet &ns,
+  const exprt &expr,
+  const exprt &result)
+{
+  if(!enabled() || !check_namespace(ns))
+    return;
+
+  if(index.find(expr)!=index.end())
+    return;
+
+  if(entries.size()>=max_size)
+  {
+    // evict the least recently used entry
+    index.erase(entries.back().first);
+    entries.pop_back();
+    evictions++;
+  }
+
+  entries.push_front(std::make_pair(expr, result));
+  index[expr]=entries.begin();
+}
+
+void simplify_expr_cachet::clear()
+{
+  entries.clear();
+  index.clear();
+  symbols=symbolst{nullptr, nullptr, 0, 0};
+}
@@ -0,0 +1,116 @@
+/*******************************************************************\
+
+Module: Cache for the Expression Simplifier
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Cache for the Expression Simplifier
+
+#ifndef CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+#define CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+
+#include <list>
+#include <unordered_map>
+
+#include "expr.h"
+
+class namespacet;
+class symbol_tablet;
+
+/// Remembers the results of simplify_exprt::simplify for the most
+/// recently simplified expressions. The results depend on the symbols,
+/// and hence the cache is flushed whenever it is used with other symbol
+/// tables, or when the generation of one of them says that symbols have
+/// been changed or removed. The cache is disabled while its maximum size
+/// is zero, which is the default, and should be enabled only once the
+/// symbol table is no longer changed wholesale, e.g., by typechecking.
+class simplify_expr_cachet
+{
+public:
+  simplify_expr_cachet():
+    max_size(0),
+    hits(0),
+    misses(0),
+    evictions(0),
+    flushes(0),
+    symbols{nullptr, nullptr, 0, 0}
+  {
+  }
+
+  /// sets the maximum number of entries, and clears the cache and the
+  /// statistics
+  void set_max_size(std::size_t _max_size)
+  {
+    max_size=_max_size;
+    hits=misses=evictions=flushes=0;
+    clear();
+  }
+
+  bool enabled() const
+  {
+    return max_size!=0;
+  }
+
+  /// \par parameters: the namespace used for simplifying, and the
+  ///   expression before simplification
+  /// \return true if the result of simplifying the expression is known,
+  ///   which is then stored in `result`, or nil if the expression is
+  ///   unchanged by simplification
+  bool lookup(const namespacet &ns, const exprt &expr, exprt &result);
+
+  /// stores the result of simplifying an expression, which is nil if
+  /// the expression is unchanged by simplification
+  void insert(const namespacet &ns, const exprt &expr, const exprt &result);
+
+  void clear();
+
+  std::size_t size() const
+  {
+    return entries.size();
+  }
+
+  // statistics
+  std::size_t get_hits() const { return hits; }
+  std::size_t get_misses() const { return misses; }
+  std::size_t get_evictions() const { return evictions; }
+  std::size_t get_flushes() const { return flushes; }
+
+protected:
+  std::size_t max_size;
+  std::size_t hits, misses, evictions, flushes;
+
+  // the entries, most recently used first
+  typedef std::list<std::pair<exprt, exprt>> entriest;
+  entriest entries;
+
+  typedef std::unordered_map<
+    exprt, entriest::iterator, irep_full_hash, irep_full_eq> indext;
+  indext index;
+
+  // the symbol tables the entries were computed with, and their
+  // generations at the time
+  struct symbolst
+  {
+    const symbol_tablet *symbol_table1, *symbol_table2;
+    std::size_t generation1, generation2;
+
+    bool operator==(const symbolst &other) const
+    {
+      return symbol_table1==other.symbol_table1 &&
+             symbol_table2==other.symbol_table2 &&
+             generation1==other.generation1 &&
+             generation2==other.generation2;
+    }
+  };
+
+  symbolst symbols;
+
+  bool check_namespace(const namespacet &ns);
+};
+
+extern simplify_expr_cachet simplify_expr_cache;
+
+#endif // CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
@@ -0,0 +1,296 @@
+/*******************************************************************\
+
+Module: Sorted Map with Stable References
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Sorted Map with Stable References
+
+#ifndef CPROVER_UTIL_STABLE_FLAT_MAP_H
+#define CPROVER_UTIL_STABLE_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "chunk_allocator.h"
+
+/// A map that keeps its keys in a sorted vector, which makes looking up
+/// the few entries of a typical map cheap and cache-friendly. Each entry
+/// lives in a node of its own, taken from a pool, and hence references
+/// to the entries remain valid when other entries are inserted or
+/// erased, as with std::map. Iterators are invalidated by insertion and
+/// erasure.
+template<typename Key, typename T>
+class stable_flat_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<const Key, T> value_type;
+  typedef std::size_t size_type;
+
+protected:
+  struct entryt
+  {
+    Key key;
+    value_type *node;
+  };
+
+  typedef std::vector<entryt> entriest;
+
+  template<typename V, typename It>
+  class iterator_baset
+  {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename stable_flat_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V *pointer;
+    typedef V &reference;
+
+    iterator_baset()
+    {
+    }
+
+    explicit iterator_baset(It _it):it(_it)
+    {
+    }
+
+    // iterators convert to const_iterators
+    template<typename V2, typename It2>
+    // NOLINTNEXTLINE(runtime/explicit)
+    iterator_baset(const iterator_baset<V2, It2> &other):it(other.it)
+    {
+    }
+
+    reference operator*() const { return *it->node; }
+    pointer operator->() const { return it->node; }
+
+    iterator_baset &operator++() { ++it; return *this; }
+    iterator_baset &operator--() { --it; return *this; }
+
+    iterator_baset operator++(int)
+    {
+      iterator_baset tmp(*this);
+      ++it;
+      return tmp;
+    }
+
+    iterator_baset operator--(int)
+    {
+      iterator_baset tmp(*this);
+      --it;
+      return tmp;
+    }
+
+    template<typename V2, typename It2>
+    bool operator==(const iterator_baset<V2, It2> &other) const
+    {
+      return it==other.it;
+    }
+
+    template<typename V2, typename It2>
+    bool operator!=(const iterator_baset<V2, It2> &other) const
+    {
+      return it!=other.it;
+    }
+
+  protected:
+    It it;
+
+    friend class stable_flat_mapt;
+
+    template<typename V2, typename It2>
+    friend class iterator_baset;
+  };
+
+public:
+  typedef iterator_baset<value_type, typename entriest::iterator> iterator;
+  typedef iterator_baset<
+    const value_type, typename entriest::const_iterator> const_iterator;
+
+  stable_flat_mapt()
+  {
+  }
+
+  stable_flat_mapt(const stable_flat_mapt &other)
+  {
+    entries.reserve(other.entries.size());
+    for(const auto &e : other.entries)
+      entries.push_back({e.key, new_node(*e.node)});
+  }
+
+  stable_flat_mapt(stable_flat_mapt &&other)
+  {
+    entries.swap(other.entries);
+  }
+
+  ~stable_flat_mapt()
+  {
+    clear();
+  }
+
+  stable_flat_mapt &operator=(const stable_flat_mapt &other)
+  {
+    if(this!=&other)
+    {
+      stable_flat_mapt tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  stable_flat_mapt &operator=(stable_flat_mapt &&other)
+  {
+    swap(other);
+    return *this;
+  }
+
+  iterator begin() { return iterator(entries.begin()); }
+  iterator end() { return iterator(entries.end()); }
+  const_iterator begin() const { return const_iterator(entries.begin()); }
+  const_iterator end() const { return const_iterator(entries.end()); }
+
+  size_type size() const { return entries.size(); }
+  bool empty() const { return entries.empty(); }
+
+  void clear()
+  {
+    for(const auto &e : entries)
+      delete_node(e.node);
+    entries.clear();
+  }
+
+  void swap(stable_flat_mapt &other)
+  {
+    entries.swap(other.entries);
+  }
+
+  iterator find(const Key &key)
+  {
+    typename entriest::iterator it=lower_bound(entries, key);
+    return iterator(it!=entries.end() && it->key==key?it:entries.end());
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    typename entriest::const_iterator it=lower_bound(entries, key);
+    return
+      const_iterator(it!=entries.end() && it->key==key?it:entries.end());
+  }
+
+  size_type count(const Key &key) const
+  {
+    return find(key)!=end()?1:0;
+  }
+
+  T &operator[](const Key &key)
+  {
+    typename entriest::iterator it=lower_bound(entries, key);
+    if(it==entries.end() || it->key!=key)
+      it=entries.insert(it, {key, new_node(value_type(key, T()))});
+    return it->node->second;
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value)
+  {
+    typename entriest::iterator it=lower_bound(entries, value.first);
+    if(it!=entries.end() && it->key==value.first)
+      return std::make_pair(iterator(it), false);
+    it=entries.insert(it, {value.first, new_node(value)});
+    return std::make_pair(iterator(it), true);
+  }
+
+  /// Inserts an entry whose key is larger than all keys in the map.
+  void push_back(const value_type &value)
+  {
+    PRECONDITION(entries.empty() || entries.back().key<value.first);
+    entries.push_back({value.first, new_node(value)});
+  }
+
+  iterator erase(iterator pos)
+  {
+    delete_node(pos.it->node);
+    return iterator(entries.erase(pos.it));
+  }
+
+  size_type erase(const Key &key)
+  {
+    iterator it=find(key);
+    if(it==end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+
+  bool operator==(const stable_flat_mapt &other) const
+  {
+    if(entries.size()!=other.entries.size())
+      return false;
+
+    for(std::size_t i=0; i<entries.size(); i++)
+      if(entries[i].key!=other.entries[i].key ||
+         entries[i].node->second!=other.entries[i].node->second)
+        return false;
+
+    return true;
+  }
+
+  bool operator!=(const stable_flat_mapt &other) const
+  {
+    return !(*this==other);
+  }
+
+protected:
+  entriest entries;
+
+  /// Small maps are searched linearly, larger ones by bisection.
+  template<typename Entries>
+  static auto lower_bound(Entries &entries, const Key &key)
+    -> decltype(entries.begin())
+  {
+    if(entries.size()<=8)
+    {
+      auto it=entries.begin();
+      while(it!=entries.end() && it->key<key)
+        ++it;
+      return it;
+    }
+
+    return std::lower_bound(
+      entries.begin(),
+      entries.end(),
+      key,
+      [](const entryt &e, const Key &k) { return e.key<k; });
+  }
+
+  /// The pool is never destroyed, as maps with static storage duration
+  /// may be destroyed after any other static object.
+  static chunk_poolt &node_pool()
+  {
+    static chunk_poolt *pool=new chunk_poolt(4096);
+    return *pool;
+  }
+
+  static value_type *new_node(const value_type &value)
+  {
+    void *p=node_pool().allocate(sizeof(value_type));
+    INVARIANT(p!=nullptr, "all nodes have the same size");
+    return new(p) value_type(value);
+  }
+
+  static void delete_node(value_type *node)
+  {
+    node->~value_type();
+    node_pool().deallocate(node);
+  }
+};
+
+#endif // CPROVER_UTIL_STABLE_FLAT_MAP_H
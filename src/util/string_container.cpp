@@ -27,50 +27,52 @@ bool string_ptrt::operator==(const string_ptrt &other) const
 
 string_containert::~string_containert()
 {
+  for(auto &block : blocks)
+    delete[] block.load();
 }
 
-unsigned string_containert::get(const char *s)
+/// \return the block with the given index, which is allocated if need be
+std::string *string_containert::get_block(std::size_t index)
 {
-  string_ptrt string_ptr(s);
+  std::string *block=blocks[index].load(std::memory_order_acquire);
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  if(block==nullptr)
+  {
+    std::lock_guard<std::mutex> lock(blocks_mutex);
 
-  if(it!=hash_table.end())
-    return it->second;
-
-  size_t r=hash_table.size();
-
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
+    block=blocks[index].load(std::memory_order_relaxed);
 
-  hash_table[result]=r;
+    if(block==nullptr)
+    {
+      block=new std::string[block_size];
+      blocks[index].store(block, std::memory_order_release);
+    }
+  }
 
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  return block;
 }
 
-unsigned string_containert::get(const std::string &s)
+unsigned string_containert::get(const string_ptrt &s)
 {
-  string_ptrt string_ptr(s);
+  // the hash tables use the lower bits, and hence the shard is chosen
+  // by mixing in the higher ones
+  const std::size_t h=string_ptr_hash()(s);
+  shardt &shard=shards[((h*2654435761u)>>24)%number_of_shards];
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  if(it!=hash_table.end())
+  hash_tablet::iterator it=shard.hash_table.find(s);
+
+  if(it!=shard.hash_table.end())
     return it->second;
 
-  size_t r=hash_table.size();
+  unsigned r=next_number++;
 
   // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result]=r;
+  std::string &string=get_block(r>>block_bits)[r&(block_size-1)];
+  string.assign(s.s, s.len);
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  shard.hash_table[string_ptrt(string)]=r;
 
   return r;
 }
@@ -12,9 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
-#include <list>
+#include <atomic>
+#include <mutex>
+#include <string>
 #include <unordered_map>
-#include <vector>
 
 #include "string_hash.h"
 
@@ -44,17 +45,19 @@ public:
   size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
 };
 
+/// Maps strings to consecutive numbers and back. Strings can be added
+/// and looked up from several threads at once.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
@@ -64,29 +67,50 @@ public:
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    // A thread only knows a number once the string has been stored, and
+    // hence this does not need to synchronise.
+    return blocks[no>>block_bits].load(std::memory_order_relaxed)
+      [no&(block_size-1)];
   }
 
 protected:
+  // The strings are distributed over shards by their hash, each with its
+  // own lock, such that threads that add strings rarely wait for each
+  // other.
+  static const std::size_t number_of_shards=64;
+
   // the 'unsigned' ought to be size_t
   typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
     hash_tablet;
-  hash_tablet hash_table;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  struct shardt
+  {
+    std::mutex mutex;
+    hash_tablet hash_table;
+  };
+
+  shardt shards[number_of_shards];
+
+  unsigned get(const string_ptrt &s);
+
+  // The strings are stored in blocks, indexed by their number. The blocks
+  // never move, and hence the strings are stable.
+  static const unsigned block_bits=16;
+  static const std::size_t block_size=std::size_t(1)<<block_bits;
+  static const std::size_t max_blocks=std::size_t(1)<<(32-block_bits);
+
+  std::atomic<std::string *> blocks[max_blocks];
+  std::mutex blocks_mutex;
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  std::atomic<unsigned> next_number;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  std::string *get_block(std::size_t index);
 };
 
 string_containert &get_string_container();
@@ -2,8 +2,16 @@
 
 #include "symbol_table.h"
 
+#include <atomic>
+
 #include <util/invariant.h>
 
+std::size_t symbol_tablet::new_generation()
+{
+  static std::atomic<std::size_t> next_generation(0);
+  return ++next_generation;
+}
+
 /// Move or copy a new symbol to the symbol table
 /// \remark: This is a nicer interface than move and achieves the same
 /// result as both move and add
@@ -18,7 +26,12 @@ std::pair<symbolt &, bool> symbol_tablet::insert(symbolt symbol)
   std::pair<symbolst::iterator, bool> result=
     internal_symbols.emplace(symbol.name, std::move(symbol));
   symbolt &new_symbol=result.first->second;
-  if(result.second)
+  if(!result.second)
+  {
+    // the caller may change the existing symbol
+    generation=new_generation();
+  }
+  else
   {
     try
     {
@@ -113,4 +126,5 @@ void symbol_tablet::erase(const symbolst::const_iterator &entry)
   internal_symbol_module_map.erase(module_it);
 
   internal_symbols.erase(entry);
+  generation=new_generation();
 }
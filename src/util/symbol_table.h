@@ -32,12 +32,20 @@ private:
   symbol_base_mapt internal_symbol_base_map;
   symbol_module_mapt internal_symbol_module_map;
 
+  /// Changes whenever symbols may have been changed or removed, and is
+  /// never the same for two symbol tables. Adding symbols does not
+  /// change it.
+  std::size_t generation;
+
+  static std::size_t new_generation();
+
 public:
   symbol_tablet()
     : symbol_table_baset(
         internal_symbols,
         internal_symbol_base_map,
-        internal_symbol_module_map)
+        internal_symbol_module_map),
+      generation(new_generation())
   {
   }
 
@@ -48,7 +56,8 @@ public:
         internal_symbol_module_map),
       internal_symbols(other.internal_symbols),
       internal_symbol_base_map(other.internal_symbol_base_map),
-      internal_symbol_module_map(other.internal_symbol_module_map)
+      internal_symbol_module_map(other.internal_symbol_module_map),
+      generation(new_generation())
   {
   }
 
@@ -65,8 +74,10 @@ public:
         internal_symbol_module_map),
       internal_symbols(std::move(other.internal_symbols)),
       internal_symbol_base_map(std::move(other.internal_symbol_base_map)),
-      internal_symbol_module_map(std::move(other.internal_symbol_module_map))
+      internal_symbol_module_map(std::move(other.internal_symbol_module_map)),
+      generation(new_generation())
   {
+    other.generation=new_generation();
   }
 
   symbol_tablet &operator=(symbol_tablet &&other)
@@ -74,6 +85,8 @@ public:
     internal_symbols = std::move(other.internal_symbols);
     internal_symbol_base_map = std::move(other.internal_symbol_base_map);
     internal_symbol_module_map = std::move(other.internal_symbol_module_map);
+    generation=new_generation();
+    other.generation=new_generation();
     return *this;
   }
 
@@ -82,6 +95,8 @@ public:
     internal_symbols.swap(other.internal_symbols);
     internal_symbol_base_map.swap(other.internal_symbol_base_map);
     internal_symbol_module_map.swap(other.internal_symbol_module_map);
+    generation=new_generation();
+    other.generation=new_generation();
   }
 
 public:
@@ -96,7 +111,11 @@ public:
   virtual symbolt *get_writeable(const irep_idt &name) override
   {
     symbolst::iterator it = internal_symbols.find(name);
-    return it != internal_symbols.end() ? &it->second : nullptr;
+    if(it == internal_symbols.end())
+      return nullptr;
+    // the caller may change the symbol
+    generation=new_generation();
+    return &it->second;
   }
 
   virtual std::pair<symbolt &, bool> insert(symbolt symbol) override;
@@ -108,6 +127,15 @@ public:
     internal_symbols.clear();
     internal_symbol_base_map.clear();
     internal_symbol_module_map.clear();
+    generation=new_generation();
+  }
+
+  /// \return a number that is the same as before iff no symbol has been
+  ///   changed or removed since, which caches of results that depend on
+  ///   the symbols use to decide whether they are still valid
+  std::size_t get_generation() const
+  {
+    return generation;
   }
 };
 
@@ -0,0 +1,94 @@
+/*******************************************************************\
+
+Module: Micro-Benchmark for mp_integer
+
+Author:
+
+\*******************************************************************/
+
+/// \file
+/// Measures the operations on mp_integer that dominate bit-width and
+/// offset computations, i.e., on values that fit into 64 bits.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <util/mp_arith.h>
+
+typedef std::chrono::steady_clock clockt;
+
+template<typename F>
+static void run(const char *name, std::size_t iterations, F f)
+{
+  clockt::time_point start=clockt::now();
+  mp_integer result=f(iterations);
+  clockt::time_point stop=clockt::now();
+
+  double ns=
+    std::chrono::duration<double, std::nano>(stop-start).count()/iterations;
+
+  std::cout << name << ": " << ns << " ns per iteration"
+            << " (result " << result << ")\n";
+}
+
+int main(int argc, const char **argv)
+{
+  std::size_t iterations=10000000;
+  if(argc>1)
+    iterations=std::strtoul(argv[1], nullptr, 10);
+
+  run("construct", iterations, [](std::size_t n)
+  {
+    mp_integer sum=0;
+    for(std::size_t i=0; i<n; i++)
+    {
+      mp_integer x=i;
+      sum+=x.is_odd()?1:0;
+    }
+    return sum;
+  });
+
+  run("offset arithmetic", iterations, [](std::size_t n)
+  {
+    mp_integer offset=0;
+    const mp_integer element_size=12;
+    for(std::size_t i=0; i<n; i++)
+      offset=(offset+element_size*(i%7)+1)%1000003;
+    return offset;
+  });
+
+  run("bit widths", iterations, [](std::size_t n)
+  {
+    mp_integer total=0;
+    for(std::size_t i=0; i<n; i++)
+    {
+      mp_integer width=(i%64)+1;
+      if(width*8>=256)
+        total+=width/8;
+    }
+    return total;
+  });
+
+  run("copy into vector", iterations/10, [](std::size_t n)
+  {
+    std::vector<mp_integer> values;
+    for(std::size_t i=0; i<n; i++)
+      values.push_back(mp_integer(i));
+    std::vector<mp_integer> copy=values;
+    return copy.back();
+  });
+
+  run("64-bit products", iterations, [](std::size_t n)
+  {
+    const mp_integer large=string2integer("4294967311");
+    const mp_integer modulus=large+2;
+    mp_integer checksum=0;
+    for(std::size_t i=0; i<n; i++)
+      checksum=(checksum*large+i)%modulus;
+    return checksum;
+  });
+
+  return 0;
+}
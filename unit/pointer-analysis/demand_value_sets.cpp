@@ -0,0 +1,145 @@
+/*******************************************************************\
+
+ Module: demand_value_setst unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <set>
+
+#include <testing-utils/catch.hpp>
+
+#include <util/c_types.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <pointer-analysis/demand_value_sets.h>
+
+static symbol_exprt add_global(
+  symbol_tablet &symbol_table,
+  const irep_idt &name,
+  const typet &type)
+{
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.type=type;
+  symbol.is_lvalue=true;
+  symbol.is_static_lifetime=true;
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+static std::set<irep_idt> get_targets(
+  demand_value_setst &value_sets,
+  goto_programt::const_targett target,
+  const exprt &expr)
+{
+  value_setst::valuest values;
+  value_sets.get_values(target, expr, values);
+
+  std::set<irep_idt> result;
+  for(const auto &value : values)
+  {
+    if(value.id()==ID_object_descriptor)
+      result.insert(
+        to_object_descriptor_expr(value).object().get(ID_identifier));
+    else
+      result.insert(value.id());
+  }
+
+  return result;
+}
+
+SCENARIO(
+  "demand_value_sets",
+  "[core][pointer-analysis][demand_value_sets]")
+{
+  GIVEN("Assignments through pointers and unrelated ones")
+  {
+    symbol_tablet symbol_table;
+    const typet int_type=signed_int_type();
+    const pointer_typet int_pointer=pointer_type(int_type);
+
+    symbol_exprt x=add_global(symbol_table, "x", int_type);
+    symbol_exprt y=add_global(symbol_table, "y", int_type);
+    symbol_exprt z=add_global(symbol_table, "z", int_type);
+    symbol_exprt p=add_global(symbol_table, "p", int_pointer);
+    symbol_exprt q=add_global(symbol_table, "q", int_pointer);
+    symbol_exprt r=add_global(symbol_table, "r", int_pointer);
+    symbol_exprt u=add_global(symbol_table, "u", int_pointer);
+    symbol_exprt pp=
+      add_global(symbol_table, "pp", pointer_type(int_pointer));
+
+    code_typet main_type;
+    main_type.return_type()=empty_typet();
+    symbolt main_symbol;
+    main_symbol.name="main";
+    main_symbol.type=main_type;
+    symbol_table.add(main_symbol);
+
+    const namespacet ns(symbol_table);
+
+    goto_functionst goto_functions;
+    goto_functionst::goto_functiont &main_function=
+      goto_functions.function_map["main"];
+    main_function.type=main_type;
+    goto_programt &body=main_function.body;
+
+    // p=&x; q=&y; pp=&p; *pp=q; r=&z; u=r;
+    body.add_instruction()->make_assignment(
+      code_assignt(p, address_of_exprt(x)));
+    body.add_instruction()->make_assignment(
+      code_assignt(q, address_of_exprt(y)));
+    body.add_instruction()->make_assignment(
+      code_assignt(pp, address_of_exprt(p)));
+    body.add_instruction()->make_assignment(
+      code_assignt(dereference_exprt(pp, int_pointer), q));
+    body.add_instruction()->make_assignment(
+      code_assignt(r, address_of_exprt(z)));
+    body.add_instruction()->make_assignment(code_assignt(u, r));
+    body.add_instruction(END_FUNCTION);
+    goto_functions.update();
+
+    demand_value_setst value_sets(ns);
+    value_sets(goto_functions);
+    REQUIRE(value_sets.number_of_assignments()==6);
+
+    const goto_programt::const_targett target=body.instructions.begin();
+
+    WHEN("Querying a pointer written through another one")
+    {
+      std::set<irep_idt> targets=get_targets(value_sets, target, p);
+
+      THEN("The write through the pointer is taken into account")
+      {
+        REQUIRE(targets==std::set<irep_idt>({"x", "y"}));
+      }
+
+      THEN("The unrelated assignments are not")
+      {
+        REQUIRE(value_sets.number_of_active_assignments()==4);
+      }
+    }
+
+    WHEN("Querying a dereference and then another pointer")
+    {
+      std::set<irep_idt> targets=get_targets(
+        value_sets, target, dereference_exprt(pp, int_pointer));
+      REQUIRE(targets==std::set<irep_idt>({"x", "y"}));
+
+      targets=get_targets(value_sets, target, u);
+
+      THEN("The solution is extended")
+      {
+        REQUIRE(targets==std::set<irep_idt>({"z"}));
+        REQUIRE(value_sets.number_of_active_assignments()==6);
+      }
+    }
+  }
+}
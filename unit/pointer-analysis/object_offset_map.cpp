@@ -0,0 +1,92 @@
+/*******************************************************************\
+
+ Module: object_offset_mapt unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <pointer-analysis/object_offset_map.h>
+
+typedef object_offset_mapt::offsett offsett;
+
+static object_offset_mapt make_map(std::size_t from, std::size_t to)
+{
+  object_offset_mapt map;
+  for(std::size_t i=from; i<to; i++)
+    map[i*7]=offsett(mp_integer(0));
+  return map;
+}
+
+TEST_CASE(
+  "Small and large maps behave alike",
+  "[core][pointer-analysis][object_offset_map]")
+{
+  for(std::size_t size : {3, 16, 17, 200})
+  {
+    object_offset_mapt map=make_map(0, size);
+
+    REQUIRE(map.size()==size);
+    REQUIRE(map.count(7)==1);
+    REQUIRE(map.count(8)==0);
+    REQUIRE(map.at(14)==offsett(mp_integer(0)));
+
+    std::size_t last=0;
+    for(const auto &entry : map)
+    {
+      REQUIRE((entry.first==0 || last<entry.first));
+      last=entry.first;
+    }
+
+    map.erase(7);
+    REQUIRE(map.size()==size-1);
+    REQUIRE(map.find(7)==map.end());
+    REQUIRE(map!=make_map(0, size));
+    REQUIRE(map.make_union(make_map(0, size)));
+    REQUIRE(map==make_map(0, size));
+    REQUIRE(map.hash()==make_map(0, size).hash());
+  }
+}
+
+TEST_CASE(
+  "Union makes differing offsets unknown",
+  "[core][pointer-analysis][object_offset_map]")
+{
+  for(std::size_t size : {4, 40})
+  {
+    object_offset_mapt a=make_map(0, size);
+    object_offset_mapt b=make_map(size/2, size+size/2);
+    b[(size-1)*7]=offsett(mp_integer(4));
+
+    REQUIRE(!a.subsumes(b));
+    REQUIRE(a.make_union(b));
+    REQUIRE(a.size()==size+size/2);
+    REQUIRE(!a.at((size-1)*7));
+    REQUIRE(a.at((size-2)*7)==offsett(mp_integer(0)));
+
+    // unknown offsets subsume known ones, but not the other way round
+    REQUIRE(a.subsumes(b));
+    REQUIRE(!a.make_union(b));
+    REQUIRE(!b.subsumes(a));
+  }
+}
+
+TEST_CASE(
+  "Union of small maps can yield a large one",
+  "[core][pointer-analysis][object_offset_map]")
+{
+  object_offset_mapt a=make_map(0, 10);
+  object_offset_mapt b=make_map(10, 20);
+
+  REQUIRE(a.make_union(b));
+  REQUIRE(a==make_map(0, 20));
+
+  a.erase(0);
+  a.erase(7);
+  a.erase(14);
+  a.erase(21);
+  REQUIRE(a==make_map(4, 20));
+  REQUIRE(make_map(0, 20).subsumes(a));
+  REQUIRE(!a.subsumes(make_map(0, 20)));
+}
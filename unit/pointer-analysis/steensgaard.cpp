@@ -0,0 +1,218 @@
+/*******************************************************************\
+
+ Module: steensgaard_analysist unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <set>
+
+#include <testing-utils/catch.hpp>
+
+#include <util/c_types.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <pointer-analysis/steensgaard.h>
+
+static symbol_exprt add_symbol(
+  symbol_tablet &symbol_table,
+  const irep_idt &name,
+  const typet &type)
+{
+  symbolt symbol;
+  symbol.name=name;
+  symbol.base_name=name;
+  symbol.type=type;
+  symbol.is_lvalue=type.id()!=ID_code;
+  symbol.is_static_lifetime=type.id()!=ID_code;
+  symbol_table.add(symbol);
+  return symbol.symbol_expr();
+}
+
+static std::set<irep_idt> get_targets(
+  steensgaard_analysist &steensgaard,
+  goto_programt::const_targett target,
+  const exprt &expr)
+{
+  value_setst::valuest values;
+  steensgaard.get_values(target, expr, values);
+
+  std::set<irep_idt> result;
+  for(const auto &value : values)
+  {
+    if(value.id()!=ID_object_descriptor)
+      result.insert(value.id());
+    else if(to_object_descriptor_expr(value).object().id()==ID_symbol)
+      result.insert(
+        to_object_descriptor_expr(value).object().get(ID_identifier));
+    else
+      result.insert(to_object_descriptor_expr(value).object().id());
+  }
+
+  return result;
+}
+
+SCENARIO(
+  "steensgaard",
+  "[core][pointer-analysis][steensgaard]")
+{
+  GIVEN("Assignments of data and function pointers")
+  {
+    symbol_tablet symbol_table;
+    const typet int_type=signed_int_type();
+    const pointer_typet int_pointer=pointer_type(int_type);
+
+    code_typet function_type;
+    function_type.return_type()=empty_typet();
+    code_typet::parametert parameter(int_pointer);
+    parameter.set_identifier("f::a");
+    function_type.parameters().push_back(parameter);
+    const pointer_typet function_pointer=pointer_type(function_type);
+
+    symbol_exprt x=add_symbol(symbol_table, "x", int_type);
+    symbol_exprt y=add_symbol(symbol_table, "y", int_type);
+    symbol_exprt z=add_symbol(symbol_table, "z", int_type);
+    symbol_exprt w=add_symbol(symbol_table, "w", int_type);
+    symbol_exprt p=add_symbol(symbol_table, "p", int_pointer);
+    symbol_exprt q=add_symbol(symbol_table, "q", int_pointer);
+    symbol_exprt r=add_symbol(symbol_table, "r", int_pointer);
+    symbol_exprt s=add_symbol(symbol_table, "s", int_pointer);
+    symbol_exprt n=add_symbol(symbol_table, "n", int_pointer);
+    symbol_exprt a=add_symbol(symbol_table, "f::a", int_pointer);
+    symbol_exprt pp=
+      add_symbol(symbol_table, "pp", pointer_type(int_pointer));
+    symbol_exprt fp=add_symbol(symbol_table, "fp", function_pointer);
+    symbol_exprt gp=add_symbol(symbol_table, "gp", function_pointer);
+    symbol_exprt lp=add_symbol(symbol_table, "main::1::lp", function_pointer);
+    symbol_exprt f=add_symbol(symbol_table, "f", function_type);
+    symbol_exprt g=add_symbol(symbol_table, "g", function_type);
+    symbol_exprt h=add_symbol(symbol_table, "h", function_type);
+
+    code_typet main_type;
+    main_type.return_type()=empty_typet();
+    add_symbol(symbol_table, "main", main_type);
+
+    const namespacet ns(symbol_table);
+
+    goto_functionst goto_functions;
+    goto_functions.function_map["f"].type=function_type;
+    goto_functions.function_map["f"].body.add_instruction(END_FUNCTION);
+
+    goto_functionst::goto_functiont &main_function=
+      goto_functions.function_map["main"];
+    main_function.type=main_type;
+    goto_programt &body=main_function.body;
+
+    // p=&x; q=p; pp=&p; r=&y; *pp=r; s=&z; n=c?&z:NULL;
+    // fp=&f; fp=&g; gp=&h; DECL lp; lp=&h; (*fp)(&w);
+    body.add_instruction()->make_assignment(
+      code_assignt(p, address_of_exprt(x)));
+    body.add_instruction()->make_assignment(code_assignt(q, p));
+    body.add_instruction()->make_assignment(
+      code_assignt(pp, address_of_exprt(p)));
+    body.add_instruction()->make_assignment(
+      code_assignt(r, address_of_exprt(y)));
+    body.add_instruction()->make_assignment(
+      code_assignt(dereference_exprt(pp, int_pointer), r));
+    body.add_instruction()->make_assignment(
+      code_assignt(s, address_of_exprt(z)));
+    body.add_instruction()->make_assignment(
+      code_assignt(
+        n,
+        if_exprt(
+          symbol_exprt("c", bool_typet()),
+          address_of_exprt(z),
+          null_pointer_exprt(int_pointer))));
+    body.add_instruction()->make_assignment(
+      code_assignt(fp, address_of_exprt(f)));
+    body.add_instruction()->make_assignment(
+      code_assignt(fp, address_of_exprt(g)));
+    body.add_instruction()->make_assignment(
+      code_assignt(gp, address_of_exprt(h)));
+    body.add_instruction(DECL)->code=code_declt(lp);
+    body.add_instruction()->make_assignment(
+      code_assignt(lp, address_of_exprt(h)));
+
+    code_function_callt call;
+    call.function()=dereference_exprt(fp, function_type);
+    call.arguments().push_back(address_of_exprt(w));
+    body.add_instruction()->make_function_call(call);
+
+    body.add_instruction(END_FUNCTION);
+    goto_functions.update();
+
+    steensgaard_analysist steensgaard(ns);
+    steensgaard(goto_functions);
+
+    const goto_programt::const_targett target=body.instructions.begin();
+
+    THEN("Pointers assigned to each other point to the same objects")
+    {
+      REQUIRE(get_targets(steensgaard, target, p)==
+              std::set<irep_idt>({"x", "y"}));
+      REQUIRE(get_targets(steensgaard, target, q)==
+              std::set<irep_idt>({"x", "y"}));
+      REQUIRE(get_targets(steensgaard, target, r)==
+              std::set<irep_idt>({"x", "y"}));
+      REQUIRE(get_targets(steensgaard, target, dereference_exprt(pp))==
+              std::set<irep_idt>({"x", "y"}));
+    }
+
+    THEN("Unrelated pointers are kept apart")
+    {
+      REQUIRE(get_targets(steensgaard, target, s)==
+              std::set<irep_idt>({"z", "NULL-object"}));
+    }
+
+    THEN("Pointers that are never assigned are unknown")
+    {
+      const symbol_exprt t("t", int_pointer);
+      REQUIRE(get_targets(steensgaard, target, t)==
+              std::set<irep_idt>({ID_unknown}));
+
+      std::set<irep_idt> functions;
+      REQUIRE(!steensgaard.get_function_targets(
+        symbol_exprt("hp", function_pointer), functions));
+    }
+
+    THEN("Function pointers point to the functions assigned to them")
+    {
+      std::set<irep_idt> functions;
+      REQUIRE(steensgaard.get_function_targets(fp, functions));
+      REQUIRE(functions==std::set<irep_idt>({"f", "g"}));
+
+      functions.clear();
+      REQUIRE(steensgaard.get_function_targets(gp, functions));
+      REQUIRE(functions==std::set<irep_idt>({"h"}));
+    }
+
+    THEN("Declared pointers are uninitialised, but keep their targets")
+    {
+      REQUIRE(get_targets(steensgaard, target, lp)==
+              std::set<irep_idt>({"h", ID_unknown}));
+
+      std::set<irep_idt> functions;
+      REQUIRE(steensgaard.get_function_targets(lp, functions));
+      REQUIRE(functions==std::set<irep_idt>({"h"}));
+    }
+
+    THEN("Calls through function pointers bind the parameters")
+    {
+      REQUIRE(get_targets(steensgaard, target, a)==
+              std::set<irep_idt>({"w"}));
+    }
+
+    THEN("Queries do not change the classes")
+    {
+      std::size_t classes=steensgaard.number_of_classes();
+      get_targets(steensgaard, target, symbol_exprt("unseen", int_pointer));
+      REQUIRE(steensgaard.number_of_classes()==classes);
+    }
+  }
+}
@@ -0,0 +1,125 @@
+/*******************************************************************\
+
+ Module: prop_minimizet unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <solvers/prop/minimize.h>
+#include <solvers/prop/prop_conv.h>
+#include <solvers/sat/satcheck.h>
+
+/// A solver that does not report unsatisfiable cores, which makes
+/// prop_minimizet fall back to the greedy search
+class no_cores_prop_convt:public prop_conv_solvert
+{
+public:
+  no_cores_prop_convt(const namespacet &_ns, propt &_prop):
+    prop_conv_solvert(_ns, _prop)
+  {
+  }
+
+  bool has_is_in_conflict() const override
+  {
+    return false;
+  }
+};
+
+/// Wants a, b and c with weight 2, and d and e with weight 1, where a
+/// excludes b and c, and d excludes b. The most objectives of weight 2
+/// are satisfied by b and c, and then the most of weight 1 by e.
+static void minimize(
+  prop_conv_solvert &prop_conv,
+  propt &prop,
+  prop_minimizet &prop_minimize,
+  bvt &variables)
+{
+  for(std::size_t i=0; i<5; i++)
+    variables.push_back(
+      prop_conv.convert(
+        symbol_exprt("v"+std::to_string(i), bool_typet())));
+
+  const literalt a=variables[0], b=variables[1], c=variables[2],
+                 d=variables[3];
+
+  prop.lcnf({!a, !b});
+  prop.lcnf({!a, !c});
+  prop.lcnf({!d, !b});
+
+  // an objective is satisfied when its condition is false
+  for(std::size_t i=0; i<3; i++)
+    prop_minimize.objective(!variables[i], 2);
+
+  for(std::size_t i=3; i<5; i++)
+    prop_minimize.objective(!variables[i], 1);
+
+  prop_minimize();
+}
+
+SCENARIO(
+  "prop_minimize",
+  "[core][solvers][prop][minimize]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  GIVEN("A weighted instance on which greedy choices may be suboptimal")
+  {
+    satcheck_no_simplifiert core_satcheck;
+    prop_conv_solvert core_prop_conv(ns, core_satcheck);
+    prop_minimizet core_guided(core_prop_conv);
+    bvt core_variables;
+
+    satcheck_no_simplifiert greedy_satcheck;
+    no_cores_prop_convt greedy_prop_conv(ns, greedy_satcheck);
+    prop_minimizet greedy(greedy_prop_conv);
+    bvt greedy_variables;
+
+    REQUIRE(core_prop_conv.has_is_in_conflict());
+    REQUIRE(!greedy_prop_conv.has_is_in_conflict());
+
+    minimize(core_prop_conv, core_satcheck, core_guided, core_variables);
+    minimize(greedy_prop_conv, greedy_satcheck, greedy, greedy_variables);
+
+    THEN("The core-guided search satisfies the most objectives")
+    {
+      REQUIRE(core_guided.number_cores()>0);
+      REQUIRE(core_guided.number_satisfied()==3);
+
+      REQUIRE(core_prop_conv.l_get(core_variables[0]).is_false());
+      REQUIRE(core_prop_conv.l_get(core_variables[1]).is_true());
+      REQUIRE(core_prop_conv.l_get(core_variables[2]).is_true());
+      REQUIRE(core_prop_conv.l_get(core_variables[3]).is_false());
+      REQUIRE(core_prop_conv.l_get(core_variables[4]).is_true());
+    }
+
+    THEN("The greedy search satisfies no more objectives")
+    {
+      REQUIRE(greedy.number_cores()==0);
+      REQUIRE(greedy.number_satisfied()>0);
+      REQUIRE(greedy.number_satisfied()<=core_guided.number_satisfied());
+
+      // the final assignment satisfies the constraints
+      const literalt a=greedy_variables[0], b=greedy_variables[1],
+                     c=greedy_variables[2], d=greedy_variables[3];
+
+      REQUIRE(greedy_prop_conv.l_get(a).is_known());
+      REQUIRE(
+        !(greedy_prop_conv.l_get(a).is_true() &&
+          greedy_prop_conv.l_get(b).is_true()));
+      REQUIRE(
+        !(greedy_prop_conv.l_get(a).is_true() &&
+          greedy_prop_conv.l_get(c).is_true()));
+      REQUIRE(
+        !(greedy_prop_conv.l_get(d).is_true() &&
+          greedy_prop_conv.l_get(b).is_true()));
+    }
+  }
+}
@@ -0,0 +1,96 @@
+/*******************************************************************\
+
+ Module: satcheckt unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+
+#include <solvers/sat/satcheck.h>
+
+SCENARIO(
+  "satcheck_assumptions",
+  "[core][solvers][sat][satcheck]")
+{
+  GIVEN("A solver with two literals that exclude each other")
+  {
+    satcheck_no_simplifiert satcheck;
+    REQUIRE(satcheck.has_set_assumptions());
+
+    const literalt a=satcheck.new_variable();
+    const literalt b=satcheck.new_variable();
+    satcheck.lcnf({!a, !b});
+
+    WHEN("Both are assumed")
+    {
+      satcheck.set_assumptions({a, b});
+
+      THEN("The instance is unsatisfiable, and both are in the core")
+      {
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_UNSATISFIABLE);
+
+        if(satcheck.has_is_in_conflict())
+        {
+          REQUIRE(satcheck.is_in_conflict(a));
+          REQUIRE(satcheck.is_in_conflict(b));
+        }
+      }
+
+      THEN("The instance is satisfiable again without the assumptions")
+      {
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_UNSATISFIABLE);
+
+        satcheck.set_assumptions(bvt());
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_SATISFIABLE);
+
+        satcheck.set_assumptions({!a});
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_SATISFIABLE);
+        REQUIRE(satcheck.l_get(a).is_false());
+      }
+    }
+
+    WHEN("Negated literals are assumed")
+    {
+      satcheck.lcnf({a, b});
+      satcheck.set_assumptions({!a, !b});
+
+      THEN("The core names the literals as they were assumed")
+      {
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_UNSATISFIABLE);
+
+        if(satcheck.has_is_in_conflict())
+        {
+          REQUIRE(satcheck.is_in_conflict(!a));
+          REQUIRE(satcheck.is_in_conflict(!b));
+        }
+      }
+    }
+
+    WHEN("The constant true is assumed along with a literal")
+    {
+      satcheck.set_assumptions({const_literal(true), a});
+
+      THEN("The constant is ignored")
+      {
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_SATISFIABLE);
+        REQUIRE(satcheck.l_get(a).is_true());
+        REQUIRE(satcheck.l_get(b).is_false());
+      }
+    }
+
+    WHEN("The constant false is assumed")
+    {
+      satcheck.set_assumptions({const_literal(false)});
+
+      THEN("The instance is unsatisfiable under the assumption only")
+      {
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_UNSATISFIABLE);
+
+        satcheck.set_assumptions(bvt());
+        REQUIRE(satcheck.prop_solve()==propt::resultt::P_SATISFIABLE);
+      }
+    }
+  }
+}
@@ -0,0 +1,116 @@
+/*******************************************************************\
+
+ Module: chunk_allocatort unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <testing-utils/catch.hpp>
+#include <util/chunk_allocator.h>
+#include <util/irep.h>
+
+typedef std::list<std::string, chunk_allocatort<std::string>> listt;
+
+TEST_CASE("Nodes are allocated in chunks", "[core][util][chunk_allocator]")
+{
+  listt list;
+
+  for(std::size_t i=0; i<3000; i++)
+    list.push_back(std::to_string(i));
+
+  REQUIRE(list.size()==3000);
+  REQUIRE(list.front()=="0");
+  REQUIRE(list.back()=="2999");
+  REQUIRE(list.get_allocator().get_pool().number_of_chunks()==3);
+
+  // freed nodes are reused
+  list.erase(list.begin(), std::next(list.begin(), 1000));
+  for(std::size_t i=0; i<1000; i++)
+    list.push_front(std::to_string(i));
+
+  REQUIRE(list.size()==3000);
+  REQUIRE(list.get_allocator().get_pool().number_of_chunks()==3);
+}
+
+TEST_CASE("Splicing with a shared pool", "[core][util][chunk_allocator]")
+{
+  listt list;
+  list.push_back("b");
+
+  listt other(list.get_allocator());
+  other.push_back("a");
+
+  auto it=other.begin();
+  list.splice(list.begin(), other);
+
+  REQUIRE(other.empty());
+  REQUIRE(list.size()==2);
+  REQUIRE(list.begin()==it);
+  REQUIRE(*it=="a");
+}
+
+TEST_CASE("Copies and moves", "[core][util][chunk_allocator]")
+{
+  listt list;
+  list.push_back("a");
+
+  listt copy(list);
+  REQUIRE(copy==list);
+
+  listt moved(std::move(list));
+  REQUIRE(moved.size()==1);
+
+  // the source remains usable
+  list.push_back("b");
+  REQUIRE(list.size()==1);
+
+  moved.swap(list);
+  REQUIRE(moved.front()=="b");
+  REQUIRE(list.front()=="a");
+}
+
+TEST_CASE("Releasing unused chunks", "[core][util][chunk_allocator]")
+{
+  chunk_poolt pool(4);
+  std::vector<void *> objects;
+
+  for(std::size_t i=0; i<16; i++)
+    objects.push_back(pool.allocate(sizeof(int)));
+
+  REQUIRE(pool.number_of_chunks()==4);
+  REQUIRE(pool.release_unused_chunks()==0);
+
+  // free the first chunk entirely, and one object of the second
+  for(std::size_t i=0; i<5; i++)
+    pool.deallocate(objects[i]);
+
+  REQUIRE(pool.release_unused_chunks()==1);
+  REQUIRE(pool.number_of_chunks()==3);
+
+  // the remaining free object is reused before a new chunk is taken
+  REQUIRE(pool.allocate(sizeof(int))==objects[4]);
+  pool.allocate(sizeof(int));
+  REQUIRE(pool.number_of_chunks()==4);
+}
+
+TEST_CASE("Counting irep nodes", "[core][util][chunk_allocator]")
+{
+  const irept::statisticst before=irept::get_statistics();
+
+  {
+    irept a("a");
+    irept b("b");
+    a.get_sub().push_back(b);
+
+    const irept::statisticst during=irept::get_statistics();
+    REQUIRE(during.nodes_alive==before.nodes_alive+2);
+    REQUIRE(during.peak_nodes_alive>=during.nodes_alive);
+  }
+
+  REQUIRE(irept::get_statistics().nodes_alive==before.nodes_alive);
+}
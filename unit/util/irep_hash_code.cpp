@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+ Module: irept hash code unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <testing-utils/catch.hpp>
+#include <util/irep.h>
+
+static irept make_tree(const irep_idt &leaf)
+{
+  irept tree("plus");
+  tree.get_sub().push_back(irept(leaf));
+  tree.get_sub().push_back(irept("y"));
+  tree.set("type", irept("signedbv"));
+  return tree;
+}
+
+TEST_CASE("Hash codes follow modifications", "[core][util][irep]")
+{
+  irept a=make_tree("x");
+  const irept shared=a;
+  const std::size_t h=shared.hash();
+
+  REQUIRE(a.hash()==h);
+
+  // modifying the copy must not change the hash code of the original
+  a.get_sub()[0].id("z");
+  REQUIRE(shared.hash()==h);
+  REQUIRE(a.hash()==make_tree("z").hash());
+  REQUIRE(a!=shared);
+
+  // the hash code of a node that is modified through a reference that
+  // was obtained before hashing
+  irept b=make_tree("x");
+  irept &op=b.get_sub()[0];
+  REQUIRE(b.hash()==h);
+  op.id("z");
+  REQUIRE(b.hash()==make_tree("z").hash());
+}
+
+TEST_CASE("Equality with hash codes", "[core][util][irep]")
+{
+  const irept a=make_tree("x");
+  const irept b=make_tree("x");
+  const irept c=make_tree("z");
+  const irept a_copy=a, b_copy=b, c_copy=c;
+
+  REQUIRE(a.hash()==b.hash());
+  REQUIRE(a.hash()!=c.hash());
+  REQUIRE(a==b);
+  REQUIRE(a!=c);
+
+  // parents that share a child, and a parent that shares nothing with
+  // them, but is equal to one of them
+  irept d("not");
+  d.get_sub().push_back(a);
+  irept e("not");
+  e.get_sub().push_back(a);
+  irept f("not");
+  f.get_sub().push_back(c);
+  const irept d_copy=d, e_copy=e, f_copy=f;
+  irept g("not");
+  g.get_sub().push_back(make_tree("x"));
+
+  REQUIRE(d.hash()==e.hash());
+  REQUIRE(d.hash()==g.hash());
+  REQUIRE(d.hash()!=f.hash());
+  REQUIRE(d==e);
+  REQUIRE(d==g);
+  REQUIRE(d!=f);
+
+  // a node that was shared when it was hashed, and is then modified in
+  // place through a reference that was obtained before it was shared
+  irept h=make_tree("x");
+  irept &op=h.get_sub()[0];
+  {
+    const irept h_copy=h;
+    REQUIRE(h.hash()==a.hash());
+  }
+  op.id("z");
+  REQUIRE(h.hash()==c.hash());
+  REQUIRE(h==c);
+  REQUIRE(h!=a);
+}
@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+ Module: mp_integer unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <utility>
+
+#include <testing-utils/catch.hpp>
+#include <util/mp_arith.h>
+
+TEST_CASE("Small values grow into large ones", "[core][util][mp_arith]")
+{
+  mp_integer x=1;
+
+  for(unsigned i=0; i<100; i++)
+    x*=3;
+
+  REQUIRE(integer2string(x)==
+    "515377520732011331036461129765621272702107522001");
+
+  for(unsigned i=0; i<100; i++)
+    x/=3;
+
+  REQUIRE(x==1);
+}
+
+TEST_CASE("Products of 64-bit values", "[core][util][mp_arith]")
+{
+  const mp_integer max=string2integer("18446744073709551615");
+  const mp_integer product=max*max;
+
+  REQUIRE(integer2string(product)==
+    "340282366920938463426481119284349108225");
+  REQUIRE(product/max==max);
+  REQUIRE(product%max==0);
+  REQUIRE(-max*max==-product);
+}
+
+TEST_CASE("Copying and swapping values", "[core][util][mp_arith]")
+{
+  const mp_integer large=pow(mp_integer(2), 200);
+  mp_integer small=42;
+
+  mp_integer a=small;
+  mp_integer b=large;
+  REQUIRE(a==42);
+  REQUIRE(b==large);
+
+  a.swap(b);
+  REQUIRE(a==large);
+  REQUIRE(b==42);
+
+  // assigning a small value to a large one and back
+  a=b;
+  REQUIRE(a==42);
+  a=large;
+  REQUIRE(a==large);
+
+  mp_integer c=std::move(a);
+  REQUIRE(c==large);
+
+  mp_integer d(std::move(small));
+  REQUIRE(d==42);
+}
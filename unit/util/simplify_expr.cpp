@@ -15,6 +15,7 @@
 #include <util/namespace.h>
 #include <util/pointer_predicates.h>
 #include <util/simplify_expr.h>
+#include <util/simplify_expr_cache.h>
 #include <util/std_expr.h>
 #include <util/symbol_table.h>
 
@@ -145,3 +146,60 @@ TEST_CASE("Simplify Java short -> int -> short casts")
 {
   test_unnecessary_cast(java_short_type());
 }
+
+TEST_CASE("Simplify with cache")
+{
+  config.set_arch("none");
+
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+
+  simplify_expr_cache.set_max_size(2);
+
+  const exprt one=from_integer(1, signedbv_typet(32));
+  const plus_exprt one_plus_one(one, one);
+  const exprt two=from_integer(2, signedbv_typet(32));
+
+  REQUIRE(simplify_expr(one_plus_one, ns)==two);
+  REQUIRE(simplify_expr_cache.get_misses()==1);
+
+  REQUIRE(simplify_expr(one_plus_one, ns)==two);
+  REQUIRE(simplify_expr_cache.get_hits()==1);
+
+  // unchanged expressions are cached, too
+  REQUIRE(simplify_expr(two, ns)==two);
+  REQUIRE(simplify_expr(two, ns)==two);
+  REQUIRE(simplify_expr_cache.get_hits()==2);
+  REQUIRE(simplify_expr_cache.size()==2);
+
+  // the least recently used entry is evicted
+  REQUIRE(simplify_expr(one, ns)==one);
+  REQUIRE(simplify_expr_cache.get_evictions()==1);
+  REQUIRE(simplify_expr_cache.size()==2);
+
+  // adding a symbol keeps the entries
+  symbolt symbol;
+  symbol.name="x";
+  symbol.base_name="x";
+  symbol.type=signedbv_typet(32);
+  symbol_table.add(symbol);
+
+  REQUIRE(simplify_expr(one, ns)==one);
+  REQUIRE(simplify_expr_cache.get_hits()==3);
+  REQUIRE(simplify_expr_cache.get_flushes()==0);
+
+  // changing a symbol flushes the cache
+  symbol_table.get_writeable_ref("x").value=one;
+
+  REQUIRE(simplify_expr(one_plus_one, ns)==two);
+  REQUIRE(simplify_expr_cache.get_flushes()==1);
+  REQUIRE(simplify_expr_cache.size()==1);
+
+  // as does reusing the symbol table for other symbols
+  symbol_table=symbol_tablet();
+
+  REQUIRE(simplify_expr(one_plus_one, ns)==two);
+  REQUIRE(simplify_expr_cache.get_flushes()==2);
+
+  simplify_expr_cache.set_max_size(0);
+}
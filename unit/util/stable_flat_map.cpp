@@ -0,0 +1,79 @@
+/*******************************************************************\
+
+ Module: stable_flat_mapt unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <string>
+
+#include <testing-utils/catch.hpp>
+#include <util/stable_flat_map.h>
+
+typedef stable_flat_mapt<int, std::string> mapt;
+
+TEST_CASE("Entries are kept sorted", "[core][util][stable_flat_map]")
+{
+  mapt map;
+
+  for(int i : {5, 1, 20, 3, 12, 7, 9, 2, 15, 4, 11})
+    map[i]=std::to_string(i);
+
+  REQUIRE(map.size()==11);
+  REQUIRE(map.count(12)==1);
+  REQUIRE(map.count(13)==0);
+  REQUIRE(map.find(20)->second=="20");
+
+  int last=0;
+  for(const auto &entry : map)
+  {
+    REQUIRE(last<entry.first);
+    last=entry.first;
+  }
+
+  REQUIRE(!map.insert({3, "three"}).second);
+  REQUIRE(map[3]=="3");
+
+  REQUIRE(map.erase(3)==1);
+  REQUIRE(map.erase(3)==0);
+  REQUIRE(map.find(3)==map.end());
+  REQUIRE(map.size()==10);
+}
+
+TEST_CASE("References remain valid", "[core][util][stable_flat_map]")
+{
+  mapt map;
+  std::string &b=map[2];
+  b="b";
+
+  // insertions before and after the entry, and erasing another one
+  map[1]="a";
+  for(int i=3; i<100; i++)
+    map[i]="x";
+  map.erase(1);
+
+  REQUIRE(&b==&map[2]);
+  REQUIRE(b=="b");
+}
+
+TEST_CASE("Copies are independent", "[core][util][stable_flat_map]")
+{
+  mapt map;
+  map[1]="a";
+  map[2]="b";
+
+  mapt copy(map);
+  REQUIRE(copy==map);
+
+  copy[2]="c";
+  REQUIRE(copy!=map);
+  REQUIRE(map[2]=="b");
+
+  mapt moved(std::move(copy));
+  REQUIRE(moved[2]=="c");
+  REQUIRE(copy.empty());
+
+  map=moved;
+  REQUIRE(map==moved);
+}
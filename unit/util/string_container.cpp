@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+ Module: string_containert unit tests
+
+ Author:
+
+\*******************************************************************/
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <testing-utils/catch.hpp>
+#include <util/irep.h>
+#include <util/string_container.h>
+
+// together, the threads add more strings than fit into one block of the
+// container
+static const std::size_t strings_per_thread=40000;
+static const std::size_t number_of_threads=8;
+
+static std::string name(std::size_t i)
+{
+  return "string_container_test_"+std::to_string(i);
+}
+
+TEST_CASE(
+  "Interning strings from several threads",
+  "[core][util][string_container]")
+{
+  string_containert &container=get_string_container();
+
+  // the ranges of neighbouring threads overlap by half
+  std::vector<std::vector<unsigned>> numbers(number_of_threads);
+  std::vector<std::vector<unsigned>> predefined(number_of_threads);
+  std::vector<std::thread> threads;
+
+  for(std::size_t t=0; t<number_of_threads; t++)
+    threads.push_back(
+      std::thread([&container, &numbers, &predefined, t]() {
+        const std::size_t first=t*strings_per_thread/2;
+
+        for(std::size_t i=0; i<strings_per_thread; i++)
+        {
+          numbers[t].push_back(container[name(first+i)]);
+
+          if(i%1000==0)
+          {
+            predefined[t].push_back(container[""]);
+            predefined[t].push_back(container["symbol"]);
+            predefined[t].push_back(container[std::string("pointer")]);
+          }
+        }
+      }));
+
+  for(auto &thread : threads)
+    thread.join();
+
+  std::map<std::string, unsigned> string_to_number;
+  std::map<unsigned, std::string> number_to_string;
+
+  for(std::size_t t=0; t<number_of_threads; t++)
+  {
+    const std::size_t first=t*strings_per_thread/2;
+    REQUIRE(numbers[t].size()==strings_per_thread);
+
+    for(std::size_t i=0; i<strings_per_thread; i++)
+    {
+      const std::string s=name(first+i);
+      const unsigned n=numbers[t][i];
+
+      string_to_number.insert(std::make_pair(s, n));
+      number_to_string.insert(std::make_pair(n, s));
+
+      // each string has one number, and each number one string
+      REQUIRE(string_to_number[s]==n);
+      REQUIRE(number_to_string[n]==s);
+      REQUIRE(container.get_string(n)==s);
+      REQUIRE(std::string(container.c_str(n))==s);
+    }
+  }
+
+  REQUIRE(
+    string_to_number.size()==(number_of_threads+1)*strings_per_thread/2);
+  REQUIRE(number_to_string.size()==string_to_number.size());
+
+  // looking up a string again yields the same number
+  REQUIRE(container[name(0)]==string_to_number[name(0)]);
+
+  for(std::size_t t=0; t<number_of_threads; t++)
+  {
+    for(std::size_t i=0; i<predefined[t].size(); i+=3)
+    {
+      REQUIRE(predefined[t][i]==0);
+      REQUIRE(predefined[t][i+1]==static_cast<unsigned>(idt::id_symbol));
+      REQUIRE(predefined[t][i+2]==static_cast<unsigned>(idt::id_pointer));
+    }
+  }
+
+  REQUIRE(ID_symbol.get_no()==static_cast<unsigned>(idt::id_symbol));
+  REQUIRE(id2string(ID_pointer)=="pointer");
+  REQUIRE(container.get_string(ID_pointer.get_no())=="pointer");
+}